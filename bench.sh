@@ -0,0 +1,4 @@
+cd engine
+make -f linux.mk bench
+./../bin/bench
+cd ..
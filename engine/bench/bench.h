@@ -0,0 +1,38 @@
+#pragma once
+
+#include "defines.h"
+#include "core/logger.h"
+
+// every measured run takes at least this long, iteration count is grown until it does
+#define BENCH_MIN_DURATION 200000000
+#define BENCH_REPETITION_COUNT 5
+#define BENCH_MAX_ITERATION_COUNT 1000000000
+
+#define BENCH_LOG_CHANNEL "Bench"
+
+typedef struct Benchmark {
+    const char* name;
+    b8 (*Setup)(void);                  // optional, not measured
+    b8 (*Run)(const u64 iterations);    // returns false if benchmark found wrong results
+    void (*Teardown)(void);             // optional, not measured
+} Benchmark;
+
+typedef struct BenchmarkList {
+    const Benchmark* benchmarks;
+    u32 count;
+} BenchmarkList;
+
+// benchmark lists, one per file
+extern const BenchmarkList memoryBenchmarks;
+extern const BenchmarkList eventBenchmarks;
+extern const BenchmarkList loggerBenchmarks;
+extern const BenchmarkList mpscBenchmarks;
+
+// stores results, so compiler can not drop work being measured
+extern void* volatile benchSink;
+
+// restarts log system, flags apply to bench channel, output goes to sink instead of console
+void StartupBenchLogSystem(const u8 flags, const LogSink* p_sink);
+
+// log setup every benchmark runs with, only warnings and errors are written, to stderr
+void StartupDefaultBenchLogSystem(void);
@@ -0,0 +1,94 @@
+#include "bench.h"
+#include "core/event.h"
+#include "core/frame_allocator.h"
+
+#define FRAME_MEMORY_SIZE (1024 * 1024)
+#define EVENTS_PER_FRAME 64
+
+static EventType benchEventType = INVALID_EVENT_TYPE;
+static u64 receivedCount = 0;
+
+static void OnBenchEvent(const Event* p_event)
+{
+    receivedCount += *GetEventPayload(p_event, u64);
+}
+
+static b8 SetupEvents(const u16 subCount)
+{
+    // event system needs frame memory for batch subs
+    if (!StartupFrameAllocator(FRAME_MEMORY_SIZE) || !StartupEventSystem())
+    {
+        return false;
+    }
+
+    // same callback subbed many times still costs one call per sub
+    benchEventType = RegisterEventType("Bench_Event", sizeof(u64));
+    for (u16 i = 0; i < subCount; i++)
+    {
+        SubToEvent(benchEventType, OnBenchEvent);
+    }
+    receivedCount = 0;
+    return benchEventType != INVALID_EVENT_TYPE;
+}
+
+static b8 SetupEventsOneSub(void)
+{
+    return SetupEvents(1);
+}
+
+static b8 SetupEventsFourSubs(void)
+{
+    return SetupEvents(4);
+}
+
+static b8 SetupEventsMaxSubs(void)
+{
+    return SetupEvents(MAX_EVENT_TYPE_SUB_COUNT);
+}
+
+static b8 RunFireProcess(const u64 iterations)
+{
+    // every op fires one event and dispatches it, every sub must see it
+    u64 expected = receivedCount + iterations * GetEventSubCount();
+    const u64 one = 1;
+    for (u64 i = 0; i < iterations; i++)
+    {
+        FireEvent(benchEventType, &one, sizeof(one));
+        ProcessEvents();
+    }
+    return receivedCount == expected;
+}
+
+static b8 RunFireBatchProcess(const u64 iterations)
+{
+    // op is one event, events are dispatched once per frame worth of them
+    u64 expected = receivedCount + iterations * GetEventSubCount();
+    const u64 one = 1;
+    for (u64 i = 0; i < iterations; i++)
+    {
+        FireEvent(benchEventType, &one, sizeof(one));
+        if (i % EVENTS_PER_FRAME == EVENTS_PER_FRAME - 1)
+        {
+            ProcessEvents();
+            SwapFrameAllocator();
+        }
+    }
+    ProcessEvents();
+    return receivedCount == expected;
+}
+
+static void TeardownEvents(void)
+{
+    ShutdownEventSystem();
+    ShutdownFrameAllocator();
+}
+
+static const Benchmark benchmarks[] =
+{
+    { "event/fire_process_1_sub", SetupEventsOneSub, RunFireProcess, TeardownEvents },
+    { "event/fire_process_4_subs", SetupEventsFourSubs, RunFireProcess, TeardownEvents },
+    { "event/fire_process_16_subs", SetupEventsMaxSubs, RunFireProcess, TeardownEvents },
+    { "event/fire_64_process_16_subs", SetupEventsMaxSubs, RunFireBatchProcess, TeardownEvents }
+};
+
+const BenchmarkList eventBenchmarks = { benchmarks, sizeof(benchmarks) / sizeof(benchmarks[0]) };
@@ -0,0 +1,84 @@
+#include "bench.h"
+#include "core/logger.h"
+
+static u64 writtenCount = 0;
+
+// counts lines, so enabled benchmarks measure logger and not terminal
+static void WriteNullLogSink(void* p_data, const LogEntry* p_entry)
+{
+    (void)p_data;
+    (void)p_entry;
+
+    writtenCount++;
+}
+
+static const LogSink nullSink = {
+    .Write = WriteNullLogSink,
+    .Flush = null,
+    .p_data = null,
+    .flags = LOG_VERBOSITY_FLAG_ALL
+};
+
+static b8 SetupDisabledLog(void)
+{
+    // success level is compiled in, but turned off everywhere
+    StartupBenchLogSystem(LOG_VERBOSITY_FLAG_ERROR | LOG_VERBOSITY_FLAG_WARNING, &nullSink);
+    return true;
+}
+
+static b8 SetupSyncLog(void)
+{
+    StartupBenchLogSystem(LOG_VERBOSITY_FLAG_ALL, &nullSink);
+    return true;
+}
+
+static b8 SetupAsyncLog(void)
+{
+    StartupBenchLogSystem(LOG_VERBOSITY_FLAG_ALL | LOG_FLAG_ASYNC, &nullSink);
+    return true;
+}
+
+static b8 SetupBinaryLog(void)
+{
+    StartupBenchLogSystem(LOG_VERBOSITY_FLAG_ALL | LOG_FLAG_BINARY, &nullSink);
+    return true;
+}
+
+static b8 RunDisabledLog(const u64 iterations)
+{
+    // barrier makes every call read enabled flags, like calls spread thro real code do
+    u64 written = writtenCount;
+    for (u64 i = 0; i < iterations; i++)
+    {
+        LogSuccess(BENCH_LOG_CHANNEL, "Value %lu Of %s", i, "Benchmark");
+        __asm__ volatile("" ::: "memory");
+    }
+    return writtenCount == written;
+}
+
+static b8 RunEnabledLog(const u64 iterations)
+{
+    // flush, so async writer's work is part of measurement
+    u64 expected = writtenCount + iterations;
+    for (u64 i = 0; i < iterations; i++)
+    {
+        LogSuccess(BENCH_LOG_CHANNEL, "Value %lu Of %s", i, "Benchmark");
+    }
+    FlushLogs();
+    return writtenCount == expected;
+}
+
+static void TeardownLog(void)
+{
+    StartupDefaultBenchLogSystem();
+}
+
+static const Benchmark benchmarks[] =
+{
+    { "log/disabled_level", SetupDisabledLog, RunDisabledLog, TeardownLog },
+    { "log/enabled_sync", SetupSyncLog, RunEnabledLog, TeardownLog },
+    { "log/enabled_async", SetupAsyncLog, RunEnabledLog, TeardownLog },
+    { "log/enabled_binary", SetupBinaryLog, RunEnabledLog, TeardownLog }
+};
+
+const BenchmarkList loggerBenchmarks = { benchmarks, sizeof(benchmarks) / sizeof(benchmarks[0]) };
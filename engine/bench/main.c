@@ -0,0 +1,188 @@
+#include "bench.h"
+#include "core/memory.h"
+#include "platform/clock.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CHANNEL BENCH_LOG_CHANNEL
+
+void* volatile benchSink = null;
+
+static const BenchmarkList* lists[] =
+{ &memoryBenchmarks, &eventBenchmarks, &loggerBenchmarks, &mpscBenchmarks };
+
+typedef struct BenchmarkResult {
+    u64 iterations;
+    f64 nsPerOp;                        // median of repetitions
+    f64 minNsPerOp;
+    f64 allocsPerOp;
+    b8 isPassed;
+} BenchmarkResult;
+
+static b8 RunBenchmark(const Benchmark* p_benchmark, BenchmarkResult* p_result);
+static u64 MeasureBenchmark(const Benchmark* p_benchmark, const u64 iterations, u64* p_allocations, b8* p_isPassed);
+static u64 GetAllocationCount(void);
+static void WriteStderrLogSink(void* p_data, const LogEntry* p_entry);
+
+// usage: bench [name filter], results are written to stdout as json
+int main(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : null;
+
+    // startup systems every benchmark needs
+    StartupDefaultBenchLogSystem();
+    StartupMemorySystem(0);
+
+    // run every benchmark that matches filter
+    b8 isPassed = true;
+    const char* separator = "";
+    printf("{\n  \"benchmarks\": [");
+    for (u32 i = 0; i < sizeof(lists) / sizeof(lists[0]); i++)
+    {
+        for (u32 j = 0; j < lists[i]->count; j++)
+        {
+            const Benchmark* p_benchmark = &lists[i]->benchmarks[j];
+            if (filter && !strstr(p_benchmark->name, filter))
+            {
+                continue;
+            }
+
+            // benchmarks that could not be set up are left out
+            BenchmarkResult result;
+            if (!RunBenchmark(p_benchmark, &result))
+            {
+                isPassed = false;
+                continue;
+            }
+            isPassed = isPassed && result.isPassed;
+
+            printf("%s\n    {\"name\": \"%s\", \"iterations\": %lu, \"ns_per_op\": %.2f, \"min_ns_per_op\": %.2f, "
+                    "\"allocs_per_op\": %.2f, \"passed\": %s}", separator, p_benchmark->name, result.iterations,
+                    result.nsPerOp, result.minNsPerOp, result.allocsPerOp, result.isPassed ? "true" : "false");
+            fflush(stdout);
+            separator = ",";
+        }
+    }
+    printf("\n  ]\n}\n");
+
+    // shutdown systems
+    ShutdownMemorySystem();
+    ShutdownLogSystem();
+    return isPassed ? 0 : 1;
+}
+
+void StartupBenchLogSystem(const u8 flags, const LogSink* p_sink)
+{
+    // restart log system, so async writer matches benchmark
+    // only errors are on globally, so startup message does not reach stdout, which is taken by results
+    ShutdownLogSystem();
+    StartupLogSystem((flags & ~LOG_VERBOSITY_FLAG_ALL) | LOG_VERBOSITY_FLAG_ERROR);
+    LogSink console = GetConsoleLogSink();
+    RemoveLogSink(&console);
+    AddLogSink(p_sink);
+
+    // requested levels are turned on for benchmarks only
+    SetLogChannelFlags(BENCH_LOG_CHANNEL, flags & LOG_VERBOSITY_FLAG_ALL);
+}
+
+void StartupDefaultBenchLogSystem(void)
+{
+    LogSink sink = {
+        .Write = WriteStderrLogSink,
+        .Flush = null,
+        .p_data = null,
+        .flags = LOG_VERBOSITY_FLAG_ERROR | LOG_VERBOSITY_FLAG_WARNING
+    };
+    StartupBenchLogSystem(LOG_VERBOSITY_FLAG_ERROR | LOG_VERBOSITY_FLAG_WARNING, &sink);
+}
+
+static b8 RunBenchmark(const Benchmark* p_benchmark, BenchmarkResult* p_result)
+{
+    // setup is not measured
+    if (p_benchmark->Setup && !p_benchmark->Setup())
+    {
+        LogError(CHANNEL, "Benchmark Not Set Up {Name: %s}", p_benchmark->name);
+        return false;
+    }
+
+    // grow iteration count until one run takes long enough, aim a bit above minimum
+    u64 allocations = 0;
+    b8 isPassed = true;
+    u64 iterations = 1;
+    while (iterations < BENCH_MAX_ITERATION_COUNT)
+    {
+        u64 duration = MeasureBenchmark(p_benchmark, iterations, &allocations, &isPassed);
+        if (duration >= BENCH_MIN_DURATION)
+        {
+            break;
+        }
+        u64 next = duration > 0 ? (u64)((f64)iterations * BENCH_MIN_DURATION * 1.2 / duration) : iterations * 100;
+        next = next > iterations * 100 ? iterations * 100 : next;
+        next = next > iterations * 2 ? next : iterations * 2;
+        iterations = next < BENCH_MAX_ITERATION_COUNT ? next : BENCH_MAX_ITERATION_COUNT;
+    }
+
+    // measure repetitions with same iteration count
+    f64 nsPerOps[BENCH_REPETITION_COUNT];
+    u64 totalAllocations = 0;
+    for (u32 i = 0; i < BENCH_REPETITION_COUNT; i++)
+    {
+        nsPerOps[i] = (f64)MeasureBenchmark(p_benchmark, iterations, &allocations, &isPassed) / iterations;
+        totalAllocations += allocations;
+    }
+
+    // sort repetitions for median and min
+    for (u32 i = 1; i < BENCH_REPETITION_COUNT; i++)
+    {
+        for (u32 j = i; j > 0 && nsPerOps[j - 1] > nsPerOps[j]; j--)
+        {
+            f64 swap = nsPerOps[j];
+            nsPerOps[j] = nsPerOps[j - 1];
+            nsPerOps[j - 1] = swap;
+        }
+    }
+
+    // teardown is not measured
+    if (p_benchmark->Teardown)
+    {
+        p_benchmark->Teardown();
+    }
+
+    *p_result = (BenchmarkResult){
+        .iterations = iterations,
+        .nsPerOp = nsPerOps[BENCH_REPETITION_COUNT / 2],
+        .minNsPerOp = nsPerOps[0],
+        .allocsPerOp = (f64)totalAllocations / ((f64)iterations * BENCH_REPETITION_COUNT),
+        .isPassed = isPassed
+    };
+    return true;
+}
+
+static u64 MeasureBenchmark(const Benchmark* p_benchmark, const u64 iterations, u64* p_allocations, b8* p_isPassed)
+{
+    // count allocations made through memory system while running
+    u64 allocations = GetAllocationCount();
+    u64 start = GetClockNanoseconds();
+    if (!p_benchmark->Run(iterations))
+    {
+        *p_isPassed = false;
+    }
+    u64 duration = GetClockNanoseconds() - start;
+    *p_allocations = GetAllocationCount() - allocations;
+    return duration;
+}
+
+static u64 GetAllocationCount(void)
+{
+    MemoryStats stats;
+    GetMemoryStats(&stats);
+    return stats.total.allocationCount;
+}
+
+static void WriteStderrLogSink(void* p_data, const LogEntry* p_entry)
+{
+    (void)p_data;
+
+    fprintf(stderr, "[%s] %s: %.*s\n", GetLogVerbosityName(p_entry->verbosity), p_entry->channel,
+            (int)p_entry->length, p_entry->message);
+}
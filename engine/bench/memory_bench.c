@@ -0,0 +1,158 @@
+#include "bench.h"
+#include "core/memory.h"
+#include "core/stack_allocator.h"
+#include "core/linear_allocator.h"
+#include "core/pool_allocator.h"
+#include "core/tlsf_allocator.h"
+
+#define REQUEST_SIZE 64
+#define REQUESTS_PER_RESET 1024
+#define LIVE_ALLOCATION_COUNT 64
+#define TLSF_MEMORY_SIZE (1024 * 1024)
+
+static StackAllocator stackAllocator;
+static LinearAllocator linearAllocator;
+static PoolAllocator poolAllocator;
+static TLSFAllocator tlsfAllocator;
+
+// tlsf memory must not come from memory system
+static _Alignas(16) u8 tlsfMemory[TLSF_MEMORY_SIZE];
+
+// sizes of mixed size benchmarks, cycled thro
+static const u32 mixedSizes[] =
+{ 16, 48, 256, 32, 1024, 64, 128, 24, 512, 80, 16, 192, 40, 768, 96, 320 };
+
+static b8 SetupStackAllocator(void)
+{
+    return CreateStackAllocator(&stackAllocator, (REQUEST_SIZE + STACK_ALLOCATOR_GUARD_SIZE) * REQUESTS_PER_RESET,
+            MEMORY_TAG_ALLOCATOR);
+}
+
+static b8 RunStackAllocator(const u64 iterations)
+{
+    // fill allocator, then drop everything at once
+    for (u64 i = 0; i < iterations; i++)
+    {
+        if (i % REQUESTS_PER_RESET == 0)
+        {
+            FreeStackAllocatorToMarker(&stackAllocator, 0);
+        }
+        benchSink = RequestStackAllocatorMemory(&stackAllocator, REQUEST_SIZE);
+    }
+    FreeStackAllocatorToMarker(&stackAllocator, 0);
+    return true;
+}
+
+static void TeardownStackAllocator(void)
+{
+    DestroyStackAllocator(&stackAllocator);
+}
+
+static b8 SetupLinearAllocator(void)
+{
+    return CreateLinearAllocator(&linearAllocator, REQUEST_SIZE * REQUESTS_PER_RESET, MEMORY_TAG_ALLOCATOR);
+}
+
+static b8 RunLinearAllocator(const u64 iterations)
+{
+    for (u64 i = 0; i < iterations; i++)
+    {
+        if (i % REQUESTS_PER_RESET == 0)
+        {
+            ResetLinearAllocator(&linearAllocator);
+        }
+        benchSink = RequestLinearAllocatorMemory(&linearAllocator, REQUEST_SIZE, DEFAULT_MEMORY_ALIGNMENT);
+    }
+    ResetLinearAllocator(&linearAllocator);
+    return true;
+}
+
+static void TeardownLinearAllocator(void)
+{
+    DestroyLinearAllocator(&linearAllocator);
+}
+
+static b8 SetupPoolAllocator(void)
+{
+    return CreatePoolAllocator(&poolAllocator, REQUEST_SIZE, LIVE_ALLOCATION_COUNT, 1, MEMORY_TAG_ALLOCATOR);
+}
+
+static b8 RunPoolAllocator(const u64 iterations)
+{
+    // keep pool full, every op releases oldest slot and acquires new one
+    PoolHandle handles[LIVE_ALLOCATION_COUNT];
+    for (u32 i = 0; i < LIVE_ALLOCATION_COUNT; i++)
+    {
+        AcquirePoolSlot(&poolAllocator, &handles[i]);
+    }
+    for (u64 i = 0; i < iterations; i++)
+    {
+        PoolHandle* p_handle = &handles[i % LIVE_ALLOCATION_COUNT];
+        ReleasePoolSlot(&poolAllocator, *p_handle);
+        benchSink = AcquirePoolSlot(&poolAllocator, p_handle);
+    }
+    for (u32 i = 0; i < LIVE_ALLOCATION_COUNT; i++)
+    {
+        ReleasePoolSlot(&poolAllocator, handles[i]);
+    }
+    return true;
+}
+
+static void TeardownPoolAllocator(void)
+{
+    DestroyPoolAllocator(&poolAllocator);
+}
+
+static b8 SetupTLSFAllocator(void)
+{
+    return CreateTLSFAllocator(&tlsfAllocator, tlsfMemory, sizeof(tlsfMemory), MEMORY_TAG_ALLOCATOR);
+}
+
+static b8 RunTLSFAllocator(const u64 iterations)
+{
+    // keep mixed sizes alive, every op frees oldest block and requests new one
+    void* blocks[LIVE_ALLOCATION_COUNT];
+    for (u32 i = 0; i < LIVE_ALLOCATION_COUNT; i++)
+    {
+        blocks[i] = RequestTLSFMemory(&tlsfAllocator, mixedSizes[i % (sizeof(mixedSizes) / sizeof(mixedSizes[0]))]);
+    }
+    for (u64 i = 0; i < iterations; i++)
+    {
+        void** p_block = &blocks[i % LIVE_ALLOCATION_COUNT];
+        FreeTLSFMemory(&tlsfAllocator, *p_block);
+        *p_block = RequestTLSFMemory(&tlsfAllocator, mixedSizes[(i * 7) % (sizeof(mixedSizes) / sizeof(mixedSizes[0]))]);
+        benchSink = *p_block;
+    }
+    for (u32 i = 0; i < LIVE_ALLOCATION_COUNT; i++)
+    {
+        FreeTLSFMemory(&tlsfAllocator, blocks[i]);
+    }
+    return true;
+}
+
+static void TeardownTLSFAllocator(void)
+{
+    DestroyTLSFAllocator(&tlsfAllocator);
+}
+
+static b8 RunAllocateMemory(const u64 iterations)
+{
+    for (u64 i = 0; i < iterations; i++)
+    {
+        void* memory = AllocateMemory(REQUEST_SIZE, MEMORY_TAG_UNKNOWN);
+        benchSink = memory;
+        FreeMemory(memory, REQUEST_SIZE, MEMORY_TAG_UNKNOWN);
+    }
+    return true;
+}
+
+static const Benchmark benchmarks[] =
+{
+    { "memory/stack_allocator_request", SetupStackAllocator, RunStackAllocator, TeardownStackAllocator },
+    { "memory/linear_allocator_request", SetupLinearAllocator, RunLinearAllocator, TeardownLinearAllocator },
+    { "memory/pool_allocator_release_acquire", SetupPoolAllocator, RunPoolAllocator, TeardownPoolAllocator },
+    { "memory/tlsf_free_request_mixed", SetupTLSFAllocator, RunTLSFAllocator, TeardownTLSFAllocator },
+    { "memory/allocate_free", null, RunAllocateMemory, null }
+};
+
+const BenchmarkList memoryBenchmarks = { benchmarks, sizeof(benchmarks) / sizeof(benchmarks[0]) };
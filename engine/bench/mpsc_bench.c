@@ -0,0 +1,110 @@
+#include "bench.h"
+#include "core/mpsc_queue.h"
+#include "platform/thread.h"
+#include <stdatomic.h>
+
+#define QUEUE_CAPACITY 4096
+#define PRODUCER_COUNT 4
+
+// producers tag elements, so consumer can check per producer order
+typedef struct BenchElement {
+    u32 producer;
+    u32 sequence;
+} BenchElement;
+
+typedef struct BenchProducer {
+    Thread thread;
+    u32 index;
+    u64 count;
+} BenchProducer;
+
+static MPSCQueue queue;
+
+static b8 SetupQueue(void)
+{
+    return CreateMPSCQueue(&queue, sizeof(BenchElement), QUEUE_CAPACITY, MEMORY_TAG_ALLOCATOR);
+}
+
+static b8 RunPushPop(const u64 iterations)
+{
+    // uncontended op, one push and one pop
+    BenchElement element = { 0 };
+    for (u64 i = 0; i < iterations; i++)
+    {
+        element.sequence = i;
+        PushMPSCQueue(&queue, &element);
+        PopMPSCQueue(&queue, &element);
+    }
+    return element.sequence == (u32)(iterations - 1);
+}
+
+static void* RunProducer(void* p_data)
+{
+    BenchProducer* p_producer = p_data;
+
+    // retry until consumer makes space
+    for (u64 i = 0; i < p_producer->count; i++)
+    {
+        BenchElement element = { .producer = p_producer->index, .sequence = i };
+        while (!PushMPSCQueue(&queue, &element));
+    }
+    return null;
+}
+
+static b8 RunContendedPushPop(const u64 iterations)
+{
+    // op is one element going thro queue, producers split them
+    BenchProducer producers[PRODUCER_COUNT];
+    u32 expectedSequences[PRODUCER_COUNT] = { 0 };
+    u32 producerCount = 0;
+    for (u32 i = 0; i < PRODUCER_COUNT; i++)
+    {
+        producers[i].index = i;
+        producers[i].count = iterations / PRODUCER_COUNT + (i < iterations % PRODUCER_COUNT ? 1 : 0);
+        if (!CreateThread(&producers[i].thread, RunProducer, &producers[i]))
+        {
+            break;
+        }
+        producerCount++;
+    }
+
+    // consume everything, elements of one producer must come in order they were pushed
+    u64 expected = 0;
+    for (u32 i = 0; i < producerCount; i++)
+    {
+        expected += producers[i].count;
+    }
+    b8 isOrdered = true;
+    for (u64 popped = 0; popped < expected;)
+    {
+        BenchElement element;
+        if (!PopMPSCQueue(&queue, &element))
+        {
+            continue;
+        }
+        isOrdered = isOrdered && element.producer < producerCount &&
+            element.sequence == expectedSequences[element.producer];
+        expectedSequences[element.producer % PRODUCER_COUNT] = element.sequence + 1;
+        popped++;
+    }
+
+    // wait for producers
+    for (u32 i = 0; i < producerCount; i++)
+    {
+        JoinThread(&producers[i].thread);
+    }
+    return isOrdered && producerCount == PRODUCER_COUNT;
+}
+
+static void TeardownQueue(void)
+{
+    DestroyMPSCQueue(&queue);
+}
+
+static const Benchmark benchmarks[] =
+{
+    { "mpsc/push_pop", SetupQueue, RunPushPop, TeardownQueue },
+    { "mpsc/push_pop_4_producers", SetupQueue, RunContendedPushPop, TeardownQueue }
+};
+
+const BenchmarkList mpscBenchmarks = { benchmarks, sizeof(benchmarks) / sizeof(benchmarks[0]) };
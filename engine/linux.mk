@@ -1,12 +1,28 @@
 COMPILER = clang
 SOURCES = $(shell find src -name *.c)
-LIBRARIES = -lX11 -lvulkan
+BENCH_SOURCES = $(shell find bench -name *.c)
+TEST_SOURCES = $(shell find test -name *.c)
+LIBRARIES = -lX11 -lXi -lxcb -lxcb-xinput -lvulkan -lpthread
 FLAGS = -Wall -Wextra -fPIC -shared -Isrc
 RELEASE_FLAGS = -O3
 DEBUG_FLAGS = -g -DDEBUG -O0
+PROFILE_FLAGS = -O3 -DPROFILING
+BENCH_FLAGS = -Wall -Wextra -Isrc -O3
+TEST_FLAGS = -Wall -Wextra -Isrc -g -DDEBUG -O2
 
 release:
 	$(COMPILER) $(SOURCES) $(LIBRARIES) $(FLAGS) $(RELEASE_FLAGS) -o ../bin/libengine.so
 
 debug:
 	$(COMPILER) $(SOURCES) $(LIBRARIES) $(FLAGS) $(DEBUG_FLAGS) -o ../bin/libengine.so
+
+profile:
+	$(COMPILER) $(SOURCES) $(LIBRARIES) $(FLAGS) $(PROFILE_FLAGS) -o ../bin/libengine.so
+
+.PHONY: bench
+bench:
+	$(COMPILER) $(SOURCES) $(BENCH_SOURCES) $(LIBRARIES) $(BENCH_FLAGS) -o ../bin/bench
+
+.PHONY: test
+test:
+	$(COMPILER) $(SOURCES) $(TEST_SOURCES) $(LIBRARIES) $(TEST_FLAGS) -o ../bin/test
@@ -8,4 +8,7 @@ void LogAssertionFailure(const char* channel, const char* error,
     LogError(channel,
             "Assertion Failure \"%s\": %s { File: \"%s\", Function: \"%s\", Line: %d }",
             error, message, file, function, line);
+
+    // debug break comes next, so write message out now
+    FlushLogs();
 }
@@ -1,7 +1,11 @@
 #include "core/event.h"
 #include "core/assert.h"
 #include "core/logger.h"
+#include "core/profiler.h"
+#include "core/memory.h"
 #include "core/stack_allocator.h"
+#include "core/frame_allocator.h"
+#include "core/mpsc_queue.h"
 #include <inttypes.h>
 #include <string.h>
 
@@ -11,13 +15,59 @@ static b8 initialized = false;
 
 static StackAllocator allocator;
 
-static Event* events;
-static u16 eventCount = 0;
-static EventSub* eventSubs;
+static EventQueue queue;
+
+// events posted from other threads, drained into queue by ProcessEvents
+static MPSCQueue postedEvents;
+static _Atomic u32 droppedPostCount = 0;
+
+// buffers replaced by growth while callbacks still hold pointers into them, freed after dispatch
+// capacity doubles from initial to max capacity, so one dispatch can retire at most this many
+#define MAX_RETIRED_QUEUE_COUNT 6
+static Event* retiredEvents[MAX_RETIRED_QUEUE_COUNT];
+static u32 retiredCapacities[MAX_RETIRED_QUEUE_COUNT];
+static u32 retiredCount = 0;
+
+// queue positions ProcessEvents is dispatching, their slots must not be reused until it is done
+static b8 isDispatching = false;
+static u32 dispatchHead = 0;
+static u32 dispatchTail = 0;
+
+// subscribers are kept per type, so dispatch never looks at unrelated subs
+static EventSubList* eventSubs;
 static u16 eventSubCount = 0;
+static u16 batchSubCount = 0;
+
+// observer of every dispatched event, used by event recorder
+static EventCallback eventTap = null;
+
+// interned type names, index is type id
+static char (*typeNames)[MAX_EVENT_TYPE_LENGTH];
+static u32 typeCount = 0;
+
+// payload size of every type, index is type id
+static u16 payloadSizes[MAX_EVENT_TYPE_COUNT];
+
+// coalescing rule of every type, index is type id
+static EventCoalesceMode coalesceModes[MAX_EVENT_TYPE_COUNT];
+static EventCombineCallback combineCallbacks[MAX_EVENT_TYPE_COUNT];
+
+// queue position + 1 of last queued event of every type, 0 if none is queued
+static u32 lastEvents[MAX_EVENT_TYPE_COUNT];
+
+static Event* FindLastEvent(const EventType type);
+static Event* PushEvent(const EventType type);
+static void QueueEvent(const EventType type, const void* p_payload, const u16 size);
+static b8 GrowEventQueue(void);
+static void DispatchEventBatches(const u32 head, const u32 tail);
+static void DrainPostedEvents(void);
+static void CombineMouseMotion(void* p_queuedPayload, const void* p_payload);
+static b8 IsEventDispatching(const u32 position);
 
 b8 StartupEventSystem(void)
 {
+    PROFILE_FUNCTION();
+
     // make sure system is not started
     Assert(CHANNEL, initialized == false, "System Is Already Initialized");
 
@@ -26,10 +76,11 @@ b8 StartupEventSystem(void)
             !CreateStackAllocator
             (
              &allocator,
-             MAX_EVENT_COUNT * sizeof(Event) +                            // events array
-             MAX_EVENT_SUB_COUNT * sizeof(EventSub) +                           // eventsubs array
-             MAX_EVENT_TYPE_LENGTH * (MAX_EVENT_COUNT + MAX_EVENT_SUB_COUNT) +  // event and eventsub types
-             MAX_EVENT_ARG_KEY_LENGTH * MAX_EVENT_COUNT * MAX_EVENT_ARG_COUNT   // event arg keys
+             MAX_EVENT_TYPE_COUNT * sizeof(EventSubList) +                      // eventsubs table
+             MAX_EVENT_TYPE_COUNT * MAX_EVENT_TYPE_LENGTH +                     // type names
+             _Alignof(EventSubList) +                                           // alignment padding
+             STACK_ALLOCATOR_GUARD_SIZE * 2,                                    // guard of every request
+             MEMORY_TAG_EVENTS
             )
        )
     {
@@ -37,38 +88,56 @@ b8 StartupEventSystem(void)
         return false;
     }
 
-    // request heap memory for events array 
-    events = RequestStackAllocatorMemory(&allocator, MAX_EVENT_COUNT * sizeof(Event));
-
-    // request heap memory for event subs array 
-    eventSubs = RequestStackAllocatorMemory(&allocator, MAX_EVENT_SUB_COUNT * sizeof(EventSub));
-
-    // loop thro events
-    for (fu16 i = 0; i < MAX_EVENT_COUNT; i++)
+    // allocate event queue on heap, it can grow later
+    queue = (EventQueue){ .capacity = EVENT_QUEUE_INITIAL_CAPACITY, .policy = EVENT_QUEUE_POLICY_GROW };
+    queue.events = AllocateMemory(queue.capacity * sizeof(Event), MEMORY_TAG_EVENTS);
+    if (!queue.events)
     {
-        // request memory for event types
-        events[i].type = RequestStackAllocatorMemory(&allocator, MAX_EVENT_TYPE_LENGTH);
-
-        // loop thro event args
-        for (fu8 j = 0; j < MAX_EVENT_ARG_COUNT; j++)
-        {
-            // request memory for event args
-            events[i].args[j].key = RequestStackAllocatorMemory(&allocator, MAX_EVENT_ARG_KEY_LENGTH);
-        }
+        LogError(CHANNEL, "Event Queue Allocation Failed");
+        DestroyStackAllocator(&allocator);
+        return false;
     }
 
-    // request memory for event sub types
-    for (fu16 i = 0; i < MAX_EVENT_SUB_COUNT; i++)
+    // create queue for events posted from other threads
+    if (!CreateMPSCQueue(&postedEvents, sizeof(Event), EVENT_POST_QUEUE_CAPACITY, MEMORY_TAG_EVENTS))
     {
-        eventSubs[i].type = RequestStackAllocatorMemory(&allocator, MAX_EVENT_TYPE_LENGTH);
+        LogError(CHANNEL, "Post Queue Not Created");
+        FreeMemory(queue.events, queue.capacity * sizeof(Event), MEMORY_TAG_EVENTS);
+        DestroyStackAllocator(&allocator);
+        return false;
     }
+    atomic_store(&droppedPostCount, 0);
+
+    // request heap memory for event subs table
+    eventSubs = RequestStackAllocatorMemoryAligned(&allocator,
+            MAX_EVENT_TYPE_COUNT * sizeof(EventSubList), _Alignof(EventSubList));
+
+    // request heap memory for type names
+    typeNames = RequestStackAllocatorMemory(&allocator, MAX_EVENT_TYPE_COUNT * MAX_EVENT_TYPE_LENGTH);
 
     // zero out array lengths
-    eventCount = 0;
     eventSubCount = 0;
+    batchSubCount = 0;
+    typeCount = 0;
+    memset(eventSubs, 0, MAX_EVENT_TYPE_COUNT * sizeof(EventSubList));
+    memset(lastEvents, 0, sizeof(lastEvents));
 
     // track system startup
     initialized = true;
+
+    // register built in types, so their ids match defines
+    RegisterEventType(EVENT_NAME_WINDOW_EXIT_REQUEST, 0);
+    RegisterEventType(EVENT_NAME_WINDOW_RESIZE, sizeof(ResizeEventPayload));
+    RegisterEventType(EVENT_NAME_KEY_PRESS, sizeof(KeyEventPayload));
+    RegisterEventType(EVENT_NAME_KEY_RELEASE, sizeof(KeyEventPayload));
+    RegisterEventType(EVENT_NAME_MOUSE_MOTION, sizeof(MouseMotionEventPayload));
+
+    // only latest size matters, so window drag queues one resize per frame
+    SetEventCoalesceMode(EVENT_TYPE_WINDOW_RESIZE, EVENT_COALESCE_LAST, null);
+
+    // high rate mice send hundreds of samples per frame, subscribers get their sum
+    SetEventCoalesceMode(EVENT_TYPE_MOUSE_MOTION, EVENT_COALESCE_ACCUMULATE, CombineMouseMotion);
+
     LogSuccess(CHANNEL, SYSTEM_INITIALIZED_MESSAGE);
 
     // return success
@@ -80,22 +149,21 @@ void ShutdownEventSystem(void)
     // make sure system is started
     Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
 
+    // destroy post queue, events still in it are lost
+    DestroyMPSCQueue(&postedEvents);
+
+    // free event queue
+    FreeMemory(queue.events, queue.capacity * sizeof(Event), MEMORY_TAG_EVENTS);
+    queue = (EventQueue){};
+
     // zero out array lengths
-    eventCount = 0;
     eventSubCount = 0;
+    batchSubCount = 0;
+    typeCount = 0;
+    eventTap = null;
 
-    // free event sub type strings
-    FreeStackAllocatorMemory(&allocator, MAX_EVENT_SUB_COUNT * MAX_EVENT_TYPE_LENGTH);
-    
-    // free event arg keys and values strings
-    FreeStackAllocatorMemory(&allocator, MAX_EVENT_COUNT * MAX_EVENT_ARG_COUNT * MAX_EVENT_ARG_KEY_LENGTH);
-    
-    // free event type strings
-    FreeStackAllocatorMemory(&allocator, MAX_EVENT_COUNT * MAX_EVENT_TYPE_LENGTH);
-
-    // free arrays from heap
-    FreeStackAllocatorMemory(&allocator, MAX_EVENT_COUNT * sizeof(Event));
-    FreeStackAllocatorMemory(&allocator, MAX_EVENT_SUB_COUNT * sizeof(EventSub));
+    // free arrays and strings from heap at once
+    FreeStackAllocatorToMarker(&allocator, 0);
 
     // destroy stack allocator
     DestroyStackAllocator(&allocator);
@@ -107,34 +175,104 @@ void ShutdownEventSystem(void)
 
 void ProcessEvents(void)
 {
+    PROFILE_FUNCTION();
+
     // make sure system is started
     Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
 
-    // loop thro event subs
-    for (fu16 i = 0; i < eventSubCount; i++)
+    // move events posted from other threads into queue
+    DrainPostedEvents();
+
+    // only dispatch what is queued now, events fired by callbacks wait for next frame
+    u32 head = queue.head;
+    u32 tail = queue.tail;
+
+    // events being dispatched can not be coalesced into anymore
+    memset(lastEvents, 0, sizeof(lastEvents));
+    isDispatching = true;
+    dispatchHead = head;
+    dispatchTail = tail;
+
+    // loop thro events in order they were fired
+    for (u32 i = head; i != tail; i++)
     {
-        // loop thro events
-        for (fu16 j = 0; j < eventCount; j++)
+        // events fired by callbacks may grow queue, so look up slot every time
+        Event* p_event = &queue.events[i & (queue.capacity - 1)];
+
+        // let tap see event first
+        if (eventTap)
         {
-            // if event sub and event type much, call its callback function
-            if (strcmp(eventSubs[i].type, events[j].type) == 0)
-            {
-                eventSubs[i].callback(&events[j]);
-                break;
-            }
+            eventTap(p_event);
+        }
+
+        // call every callback subscribed to this type
+        EventSubList* p_subs = &eventSubs[p_event->type];
+        for (fu16 j = 0; j < p_subs->count; j++)
+        {
+            p_subs->callbacks[j](p_event);
         }
     }
 
-    // clear events array
-    eventCount = 0;
+    // give batch subscribers their events as one span per type
+    if (batchSubCount > 0)
+    {
+        DispatchEventBatches(head, tail);
+    }
+
+    // remove dispatched events
+    queue.head = tail;
+    isDispatching = false;
+
+    // free buffers replaced while dispatching
+    for (u32 i = 0; i < retiredCount; i++)
+    {
+        FreeMemory(retiredEvents[i], retiredCapacities[i] * sizeof(Event), MEMORY_TAG_EVENTS);
+    }
+    retiredCount = 0;
+
+    // report lost events once per frame
+    if (queue.droppedCount > 0)
+    {
+        LogWarning(CHANNEL, "Event Queue Was Full, %d Events Dropped", queue.droppedCount);
+        queue.droppedCount = 0;
+    }
+    u32 droppedPosts = atomic_exchange_explicit(&droppedPostCount, 0, memory_order_relaxed);
+    if (droppedPosts > 0)
+    {
+        LogWarning(CHANNEL, "Post Queue Was Full, %d Events Dropped", droppedPosts);
+    }
+}
+
+u32 GetEventCount(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
+
+    return queue.tail - queue.head;
+}
+
+u32 GetEventQueueCapacity(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
+
+    return queue.capacity;
+}
+
+void SetEventQueuePolicy(const EventQueuePolicy policy)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
+
+    queue.policy = policy;
 }
 
-u16 GetEventCount(void)
+void SetEventTap(EventCallback tap)
 {
     // make sure system is started
     Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
 
-    return eventCount;
+    eventTap = tap;
 }
 
 u16 GetEventSubCount(void)
@@ -145,53 +283,160 @@ u16 GetEventSubCount(void)
     return eventSubCount;
 }
 
-void SubToEvent(const char* type, EventCallback callback)
+EventType RegisterEventType(const char* name, const u16 payloadSize)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
+
+    // check params for invalid pointers
+    Assert(CHANNEL, name != null, "Invalid Pointer Provided");
+
+    // make sure name is not longer than normal
+    Assert(CHANNEL, strlen(name) < MAX_EVENT_TYPE_LENGTH, "Too Large String Provieded");
+
+    // make sure payload fits in event
+    Assert(CHANNEL, payloadSize <= MAX_EVENT_PAYLOAD_SIZE, "Too Large Payload Size Provided");
+
+    // return id if type is already registered
+    EventType type = FindEventType(name);
+    if (type != INVALID_EVENT_TYPE)
+    {
+        // make sure both registrations agree on payload
+        if (payloadSizes[type] != payloadSize)
+        {
+            LogError(CHANNEL, "Event \"%s\" Is Registered With Different Payload {Size: %dB, Requested: %dB}",
+                    name, payloadSizes[type], payloadSize);
+            return INVALID_EVENT_TYPE;
+        }
+
+        return type;
+    }
+
+    // make sure there is space for new type
+    if (typeCount == MAX_EVENT_TYPE_COUNT)
+    {
+        LogError(CHANNEL, "Too Many Event Types, \"%s\" Not Registered", name);
+        return INVALID_EVENT_TYPE;
+    }
+
+    // store name and payload size, their index is new id
+    strcpy(typeNames[typeCount], name);
+    payloadSizes[typeCount] = payloadSize;
+    coalesceModes[typeCount] = EVENT_COALESCE_NONE;
+    combineCallbacks[typeCount] = null;
+    return typeCount++;
+}
+
+EventType FindEventType(const char* name)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
+
+    // check params for invalid pointers
+    Assert(CHANNEL, name != null, "Invalid Pointer Provided");
+
+    // loop thro registered names
+    for (u32 i = 0; i < typeCount; i++)
+    {
+        if (strcmp(typeNames[i], name) == 0)
+        {
+            return i;
+        }
+    }
+
+    return INVALID_EVENT_TYPE;
+}
+
+const char* GetEventTypeName(const EventType type)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
+
+    // make sure type is registered
+    Assert(CHANNEL, type < typeCount, "Invalid Event Type Provided");
+
+    return typeNames[type];
+}
+
+u16 GetEventPayloadSize(const EventType type)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
+
+    // make sure type is registered
+    Assert(CHANNEL, type < typeCount, "Invalid Event Type Provided");
+
+    return payloadSizes[type];
+}
+
+void SetEventCoalesceMode(const EventType type, const EventCoalesceMode mode, EventCombineCallback combine)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
+
+    // make sure type is registered
+    Assert(CHANNEL, type < typeCount, "Invalid Event Type Provided");
+
+    // accumulating needs to know how to merge payloads
+    Assert(CHANNEL, mode != EVENT_COALESCE_ACCUMULATE || combine != null, "Invalid Pointer Provided");
+
+    // store rule
+    coalesceModes[type] = mode;
+    combineCallbacks[type] = combine;
+}
+
+void SubToEvent(const EventType type, EventCallback callback)
 {
     // make sure system is started
     Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
 
     // check params for invalid pointers
-    Assert(CHANNEL, type != null, "Invalid Pointer Provided");
     Assert(CHANNEL, callback != null, "Invalid Pointer Provided");
 
-    // make sure type is not longer than normal
-    Assert(CHANNEL, strlen(type) < MAX_EVENT_TYPE_LENGTH, "Too Large String Provieded");
+    // make sure type is registered
+    Assert(CHANNEL, type < typeCount, "Invalid Event Type Provided");
 
-    // store type
-    strcpy(eventSubs[eventSubCount].type, type);
+    // make sure there is space for new sub
+    EventSubList* p_subs = &eventSubs[type];
+    if (p_subs->count == MAX_EVENT_TYPE_SUB_COUNT)
+    {
+        LogError(CHANNEL, "Too Many Subs For Event \"%s\"", typeNames[type]);
+        return;
+    }
 
     // store callback
-    eventSubs[eventSubCount].callback = callback;
+    p_subs->callbacks[p_subs->count++] = callback;
 
     // resize array
     eventSubCount++;
 }
 
-void UnsubToEvent(const char* type, EventCallback callback)
+void UnsubToEvent(const EventType type, EventCallback callback)
 {
     // make sure system is started
     Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
 
     // check params for invalid pointers
-    Assert(CHANNEL, type != null, "Invalid Pointer Provided");
     Assert(CHANNEL, callback != null, "Invalid Pointer Provided");
 
-    // make sure type is not longer than normal
-    Assert(CHANNEL, strlen(type) < MAX_EVENT_TYPE_LENGTH, "Too Large String Provieded");
+    // make sure type is registered
+    Assert(CHANNEL, type < typeCount, "Invalid Event Type Provided");
 
-    // loop thro event subs
-    for (fu16 i = 0; i < eventSubCount; i++)
+    // loop thro subs of this type
+    EventSubList* p_subs = &eventSubs[type];
+    for (fu16 i = 0; i < p_subs->count; i++)
     {
-        // check if types muches
-        if (strcmp(eventSubs[i].type, type) == 0)
+        // check if callbacks much
+        if (p_subs->callbacks[i] == callback)
         {
-            // remove sub from array
-            for (fu16 j = i; j < eventSubCount - 1; j++)
+            // remove sub from array, keeping order
+            for (fu16 j = i; j + 1 < p_subs->count; j++)
             {
-                eventSubs[j] = eventSubs[j + 1];
+                p_subs->callbacks[j] = p_subs->callbacks[j + 1];
             }
 
             // resize array
+            p_subs->count--;
             eventSubCount--;
 
             // exit function
@@ -200,47 +445,61 @@ void UnsubToEvent(const char* type, EventCallback callback)
     }
 }
 
-void FireEvent(const char* type)
+void SubToEventBatch(const EventType type, EventBatchCallback callback)
 {
     // make sure system is started
     Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
 
-    // check params for invalid pointesr
-    Assert(CHANNEL, type != null, "Invalid Pointer Provided");
+    // check params for invalid pointers
+    Assert(CHANNEL, callback != null, "Invalid Pointer Provided");
 
-    // make sure type is not longer than normal
-    Assert(CHANNEL, strlen(type) < MAX_EVENT_TYPE_LENGTH, "Too Large String Provieded");
+    // make sure type is registered
+    Assert(CHANNEL, type < typeCount, "Invalid Event Type Provided");
 
-    // store type
-    strcpy(events[eventCount].type, type);
+    // make sure there is space for new sub
+    EventSubList* p_subs = &eventSubs[type];
+    if (p_subs->batchCount == MAX_EVENT_TYPE_SUB_COUNT)
+    {
+        LogError(CHANNEL, "Too Many Batch Subs For Event \"%s\"", typeNames[type]);
+        return;
+    }
+
+    // store callback
+    p_subs->batchCallbacks[p_subs->batchCount++] = callback;
 
     // resize array
-    eventCount++;
+    eventSubCount++;
+    batchSubCount++;
 }
 
-void SetEventArgI32(const char* type, const u32 index, const char* key, const i32 value)
+void UnsubToEventBatch(const EventType type, EventBatchCallback callback)
 {
     // make sure system is started
     Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
 
     // check params for invalid pointers
-    Assert(CHANNEL, type != null, "Invalid String Provided");
-    Assert(CHANNEL, key != null, "Invalid String Provided");
+    Assert(CHANNEL, callback != null, "Invalid Pointer Provided");
 
-    // make sure correct index is provieded
-    Assert(CHANNEL, index < MAX_EVENT_ARG_COUNT, "Invalid Event Arg Index Provided");
+    // make sure type is registered
+    Assert(CHANNEL, type < typeCount, "Invalid Event Type Provided");
 
-    // loop thro events
-    for (fu16 i = 0; i < eventCount; i++)
+    // loop thro batch subs of this type
+    EventSubList* p_subs = &eventSubs[type];
+    for (fu16 i = 0; i < p_subs->batchCount; i++)
     {
-        // check if types much
-        if (strcmp(events[i].type, type) == 0)
+        // check if callbacks much
+        if (p_subs->batchCallbacks[i] == callback)
         {
-            // set key
-            strcpy(events[i].args[index].key, key);
+            // remove sub from array, keeping order
+            for (fu16 j = i; j + 1 < p_subs->batchCount; j++)
+            {
+                p_subs->batchCallbacks[j] = p_subs->batchCallbacks[j + 1];
+            }
 
-            // set value
-            events[i].args[index].value.asI32 = value;
+            // resize array
+            p_subs->batchCount--;
+            eventSubCount--;
+            batchSubCount--;
 
             // exit function
             return;
@@ -248,59 +507,307 @@ void SetEventArgI32(const char* type, const u32 index, const char* key, const i3
     }
 }
 
-void SetEventArg(const char* type, const u32 index, const char* key, const EventArgValue value)
+void FireEvent(const EventType type, const void* p_payload, const u16 size)
 {
     // make sure system is started
     Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
 
-    // check params for invalid pointers
-    Assert(CHANNEL, type != null, "Invalid String Provided");
-    Assert(CHANNEL, key != null, "Invalid String Provided");
+    // reject unregistered types and payloads that do not match type, they would overflow event payload
+    if (type >= typeCount || size != payloadSizes[type] || (size > 0 && !p_payload))
+    {
+        LogWarning(CHANNEL, "Fired Event Has Invalid Type Or Payload {Type: %d, Size: %dB}", type, size);
+        return;
+    }
+
+    // add event to queue
+    QueueEvent(type, p_payload, size);
+}
+
+b8 PostEvent(const EventType type, const void* p_payload, const u16 size)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
+
+    // reject payloads that do not fit event, exact size is checked when event is drained
+    if (size > MAX_EVENT_PAYLOAD_SIZE || (size > 0 && !p_payload))
+    {
+        LogWarning(CHANNEL, "Posted Event Has Invalid Payload {Type: %d, Size: %dB}", type, size);
+        return false;
+    }
+
+    // build event on stack
+    Event event = { .type = type, .size = size };
+    if (size > 0)
+    {
+        memcpy(event.payload, p_payload, size);
+    }
+
+    // push copy of event, count it if there is no space
+    if (!PushMPSCQueue(&postedEvents, &event))
+    {
+        atomic_fetch_add_explicit(&droppedPostCount, 1, memory_order_relaxed);
+        return false;
+    }
 
-    // make sure correct index is provieded
-    Assert(CHANNEL, index < MAX_EVENT_ARG_COUNT, "Invalid Event Arg Index Provided");
+    return true;
+}
 
-    // loop thro events
-    for (fu16 i = 0; i < eventCount; i++)
+void SubToEventByName(const char* name, EventCallback callback)
+{
+    EventType type = FindEventType(name);
+    if (type == INVALID_EVENT_TYPE)
     {
-        // check if types much
-        if (strcmp(events[i].type, type) == 0)
+        LogWarning(CHANNEL, "Event \"%s\" Is Not Registered", name);
+        return;
+    }
+
+    SubToEvent(type, callback);
+}
+
+void UnsubToEventByName(const char* name, EventCallback callback)
+{
+    EventType type = FindEventType(name);
+    if (type == INVALID_EVENT_TYPE)
+    {
+        LogWarning(CHANNEL, "Event \"%s\" Is Not Registered", name);
+        return;
+    }
+
+    UnsubToEvent(type, callback);
+}
+
+void FireEventByName(const char* name, const void* p_payload, const u16 size)
+{
+    EventType type = FindEventType(name);
+    if (type == INVALID_EVENT_TYPE)
+    {
+        LogWarning(CHANNEL, "Event \"%s\" Is Not Registered", name);
+        return;
+    }
+
+    FireEvent(type, p_payload, size);
+}
+
+static Event* FindLastEvent(const EventType type)
+{
+    // make sure type is registered
+    Assert(CHANNEL, type < typeCount, "Invalid Event Type Provided");
+
+    // return null if no event of this type is queued, it was dropped from queue, or it is being dispatched
+    u32 position = lastEvents[type] - 1;
+    if (lastEvents[type] == 0 || position - queue.head >= queue.tail - queue.head || IsEventDispatching(position))
+    {
+        return null;
+    }
+
+    return &queue.events[position & (queue.capacity - 1)];
+}
+
+static Event* PushEvent(const EventType type)
+{
+    // handle full queue with current policy
+    if (queue.tail - queue.head == queue.capacity)
+    {
+        switch (queue.policy)
         {
-            // set key
-            strcpy(events[i].args[index].key, key);
+            case EVENT_QUEUE_POLICY_GROW:
+                if (!GrowEventQueue())
+                {
+                    queue.droppedCount++;
+                    return null;
+                }
+                break;
+            case EVENT_QUEUE_POLICY_DROP_NEWEST:
+                queue.droppedCount++;
+                return null;
+            case EVENT_QUEUE_POLICY_DROP_OLDEST:
+                // oldest event may be one callbacks are looking at, then newest is dropped instead
+                queue.droppedCount++;
+                if (IsEventDispatching(queue.head))
+                {
+                    return null;
+                }
+                queue.head++;
+                break;
+            case EVENT_QUEUE_POLICY_COALESCE:
+                queue.droppedCount++;
+                return FindLastEvent(type);
+        }
+    }
 
-            // set value
-            events[i].args[index].value = value;
+    // take slot at tail and remember it as last event of its type
+    Event* p_event = &queue.events[queue.tail & (queue.capacity - 1)];
+    lastEvents[type] = ++queue.tail;
+    return p_event;
+}
 
-            // exit function
+static void QueueEvent(const EventType type, const void* p_payload, const u16 size)
+{
+    // collapse into queued event of same type if type allows it
+    if (coalesceModes[type] != EVENT_COALESCE_NONE)
+    {
+        Event* p_queued = FindLastEvent(type);
+        if (p_queued)
+        {
+            if (coalesceModes[type] == EVENT_COALESCE_LAST)
+            {
+                if (size > 0)
+                {
+                    memcpy(p_queued->payload, p_payload, size);
+                }
+            }
+            else
+            {
+                combineCallbacks[type](p_queued->payload, p_payload);
+            }
             return;
         }
     }
 
-    // if code comes here, event was not found
-    LogWarning(CHANNEL, "Event \"%s\" Not Found To Set Value", type);
+    // get slot for new event
+    Event* p_event = PushEvent(type);
+    if (!p_event)
+    {
+        return;
+    }
+
+    // store type and payload
+    p_event->type = type;
+    p_event->size = size;
+    if (size > 0)
+    {
+        memcpy(p_event->payload, p_payload, size);
+    }
 }
 
-EventArgValue GetEventArg(const Event* p_event, const char* key)
+static b8 GrowEventQueue(void)
 {
-    // make sure system is started
-    Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
+    // make sure queue is allowed to grow
+    if (queue.capacity >= EVENT_QUEUE_MAX_CAPACITY)
+    {
+        return false;
+    }
 
-    // check params for invalid pointers
-    Assert(CHANNEL, p_event != null, "Invalid Pointer Provided");
-    Assert(CHANNEL, key != null, "Invalid String Provided");
+    // allocate twice bigger buffer
+    u32 capacity = queue.capacity * 2;
+    Event* events = AllocateMemory(capacity * sizeof(Event), MEMORY_TAG_EVENTS);
+    if (!events)
+    {
+        LogError(CHANNEL, "Event Queue Growth Failed");
+        return false;
+    }
+
+    // copy events, positions stay same, only wrapping changes
+    for (u32 i = queue.head; i != queue.tail; i++)
+    {
+        events[i & (capacity - 1)] = queue.events[i & (queue.capacity - 1)];
+    }
+
+    // callbacks may still hold pointers to old buffer, so free it after dispatch
+    if (isDispatching)
+    {
+        Assert(CHANNEL, retiredCount < MAX_RETIRED_QUEUE_COUNT, "Too Many Queue Buffers Retired");
+        retiredEvents[retiredCount] = queue.events;
+        retiredCapacities[retiredCount] = queue.capacity;
+        retiredCount++;
+    }
+    else
+    {
+        FreeMemory(queue.events, queue.capacity * sizeof(Event), MEMORY_TAG_EVENTS);
+    }
+
+    // use new buffer
+    queue.events = events;
+    queue.capacity = capacity;
+    LogInfo(CHANNEL, "Event Queue Grown To %d Events", capacity);
+    return true;
+}
+
+static void DispatchEventBatches(const u32 head, const u32 tail)
+{
+    // count events of every type that has batch subs
+    u32 offsets[MAX_EVENT_TYPE_COUNT] = {};
+    u32 batchEventCount = 0;
+    for (u32 i = head; i != tail; i++)
+    {
+        EventType type = queue.events[i & (queue.capacity - 1)].type;
+        if (eventSubs[type].batchCount > 0)
+        {
+            offsets[type]++;
+            batchEventCount++;
+        }
+    }
+    if (batchEventCount == 0)
+    {
+        return;
+    }
 
-    // loop thro args
-    for (fu8 i = 0; i < MAX_EVENT_ARG_COUNT; i++)
+    // sort events by type into frame memory, keeping fire order inside every type
+    Event* batches = RequestFrameMemoryAligned(batchEventCount * sizeof(Event), _Alignof(Event));
+    if (!batches)
+    {
+        LogError(CHANNEL, "Frame Memory For Event Batches Not Available");
+        return;
+    }
+    u32 starts[MAX_EVENT_TYPE_COUNT];
+    u32 start = 0;
+    for (u32 i = 0; i < typeCount; i++)
+    {
+        starts[i] = start;
+        start += offsets[i];
+        offsets[i] = starts[i];
+    }
+    for (u32 i = head; i != tail; i++)
     {
-        // if keys much, return value
-        if (strcmp(p_event->args[i].key, key) == 0)
+        Event* p_event = &queue.events[i & (queue.capacity - 1)];
+        if (eventSubs[p_event->type].batchCount > 0)
         {
-            return p_event->args[i].value;
+            batches[offsets[p_event->type]++] = *p_event;
         }
     }
 
-    // return 0 as default
-    LogWarning(CHANNEL, "Either Event Type Or Argument Is Not Found");
-    return (EventArgValue){0};
+    // call every batch callback once per type
+    for (u32 i = 0; i < typeCount; i++)
+    {
+        u32 count = offsets[i] - starts[i];
+        for (fu16 j = 0; j < eventSubs[i].batchCount && count > 0; j++)
+        {
+            eventSubs[i].batchCallbacks[j](&batches[starts[i]], count);
+        }
+    }
+}
+
+static void DrainPostedEvents(void)
+{
+    // pop events in order every producer posted them, at most one queue worth so busy producers can not stall frame
+    Event event;
+    for (u32 i = 0; i < EVENT_POST_QUEUE_CAPACITY && PopMPSCQueue(&postedEvents, &event); i++)
+    {
+        // skip events of types that were never registered, or carry wrong payload
+        if (event.type >= typeCount || event.size != payloadSizes[event.type])
+        {
+            LogWarning(CHANNEL, "Posted Event Has Invalid Type Or Payload {Type: %d, Size: %dB}", event.type, event.size);
+            continue;
+        }
+
+        // queue it like fired event, coalescing and queue policy apply
+        QueueEvent(event.type, event.payload, event.size);
+    }
+}
+
+static b8 IsEventDispatching(const u32 position)
+{
+    return isDispatching && position - dispatchHead < dispatchTail - dispatchHead;
+}
+
+static void CombineMouseMotion(void* p_queuedPayload, const void* p_payload)
+{
+    MouseMotionEventPayload* p_queued = p_queuedPayload;
+    const MouseMotionEventPayload* p_motion = p_payload;
+
+    // sum motion, keep time of latest sample
+    p_queued->deltaX += p_motion->deltaX;
+    p_queued->deltaY += p_motion->deltaY;
+    p_queued->timestamp = p_motion->timestamp;
+    p_queued->sampleCount += p_motion->sampleCount;
 }
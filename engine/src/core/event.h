@@ -2,40 +2,101 @@
 
 #include "defines.h"
 
-#define EVENT_TYPE_WINDOW_EXIT_REQUEST "Window_Exit_Request"
-#define EVENT_TYPE_WINDOW_RESIZE "Window_Resize"
-#define EVENT_TYPE_KEY_PRESS "Key_Press"
-#define EVENT_TYPE_KEY_RELEASE "Key_Release"
-
-#define MAX_EVENT_COUNT 100
-#define MAX_EVENT_SUB_COUNT 100
-#define MAX_EVENT_ARG_COUNT 5
+// built in event types, they are registered under these ids on startup
+#define EVENT_TYPE_WINDOW_EXIT_REQUEST 0
+#define EVENT_TYPE_WINDOW_RESIZE 1
+#define EVENT_TYPE_KEY_PRESS 2
+#define EVENT_TYPE_KEY_RELEASE 3
+#define EVENT_TYPE_MOUSE_MOTION 4
+#define EVENT_TYPE_BUILTIN_COUNT 5
+
+#define EVENT_NAME_WINDOW_EXIT_REQUEST "Window_Exit_Request"
+#define EVENT_NAME_WINDOW_RESIZE "Window_Resize"
+#define EVENT_NAME_KEY_PRESS "Key_Press"
+#define EVENT_NAME_KEY_RELEASE "Key_Release"
+#define EVENT_NAME_MOUSE_MOTION "Mouse_Motion"
+
+#define INVALID_EVENT_TYPE UINT32_MAX
+
+#define EVENT_QUEUE_INITIAL_CAPACITY 128
+#define EVENT_QUEUE_MAX_CAPACITY 8192
+#define EVENT_POST_QUEUE_CAPACITY 4096
+#define MAX_EVENT_TYPE_COUNT 64
+#define MAX_EVENT_TYPE_SUB_COUNT 16
 #define MAX_EVENT_TYPE_LENGTH 20
-#define MAX_EVENT_ARG_KEY_LENGTH 10
-
-typedef union EventArgValue {
-    i32 asI32;
-    u32 asU32;
-    f32 asF32;
-    char asChar;
-} EventArgValue;
-
-typedef struct EventArg {
-    char* key;
-    EventArgValue value;
-} EventArg;
-
+#define MAX_EVENT_PAYLOAD_SIZE 16
+
+typedef u32 EventType;
+
+// payload of key press and key release
+typedef struct KeyEventPayload {
+    u32 keycode;
+    u32 timestamp;
+} KeyEventPayload;
+
+// payload of window resize
+typedef struct ResizeEventPayload {
+    u16 width;
+    u16 height;
+} ResizeEventPayload;
+
+// payload of raw mouse motion, unaccelerated device units, motion fired in same frame is summed into one event
+typedef struct MouseMotionEventPayload {
+    f32 deltaX;
+    f32 deltaY;
+    u32 timestamp;                      // server time of latest sample
+    u32 sampleCount;
+} MouseMotionEventPayload;
+
+// payload is plain struct declared by event type, copied in and out with one memcpy
 typedef struct Event {
-    char* type;
-    EventArg args[MAX_EVENT_ARG_COUNT];
+    EventType type;
+    u16 size;
+    _Alignas(8) u8 payload[MAX_EVENT_PAYLOAD_SIZE];
 } Event;
 
+// typed view of event payload
+#define GetEventPayload(p_event, type) ((const type*)(p_event)->payload)
+
 typedef void (*EventCallback)(const Event* p_event);
 
-typedef struct EventSub {
-    char* type;
-    EventCallback callback;
-} EventSub;
+// merges payload of newly fired event into payload of queued one
+typedef void (*EventCombineCallback)(void* p_queuedPayload, const void* p_payload);
+
+// receives every event of its type queued this frame, in order they were fired
+typedef void (*EventBatchCallback)(const Event* p_events, const u32 count);
+
+typedef struct EventSubList {
+    u16 count;
+    u16 batchCount;
+    EventCallback callbacks[MAX_EVENT_TYPE_SUB_COUNT];
+    EventBatchCallback batchCallbacks[MAX_EVENT_TYPE_SUB_COUNT];
+} EventSubList;
+
+// what to do when event of type is fired while another one of same type is queued
+typedef enum EventCoalesceMode {
+    EVENT_COALESCE_NONE,                // keep all, every fire is own queue entry
+    EVENT_COALESCE_LAST,                // keep last, new payload overwrites queued one
+    EVENT_COALESCE_ACCUMULATE           // merge new payload into queued one with combine callback
+} EventCoalesceMode;
+
+// what to do when queue is full
+typedef enum EventQueuePolicy {
+    EVENT_QUEUE_POLICY_GROW,            // double capacity up to max capacity, then drop newest
+    EVENT_QUEUE_POLICY_DROP_NEWEST,     // drop event that is being fired
+    EVENT_QUEUE_POLICY_DROP_OLDEST,     // drop oldest queued event to make space
+    EVENT_QUEUE_POLICY_COALESCE         // overwrite latest queued event of same type, drop if there is none
+} EventQueuePolicy;
+
+// ring buffer, positions grow forever and are wrapped with capacity mask
+typedef struct EventQueue {
+    Event* events;
+    u32 capacity;
+    u32 head;
+    u32 tail;
+    u32 droppedCount;
+    EventQueuePolicy policy;
+} EventQueue;
 
 EXPORT b8 StartupEventSystem(void);
 
@@ -43,20 +104,47 @@ EXPORT void ShutdownEventSystem(void);
 
 EXPORT void ProcessEvents(void);
 
-EXPORT u16 GetEventCount(void);
+EXPORT u32 GetEventCount(void);
+
+EXPORT u32 GetEventQueueCapacity(void);
+
+EXPORT void SetEventQueuePolicy(const EventQueuePolicy policy);
+
+// tap sees every event ProcessEvents dispatches, before its subscribers, null removes it
+EXPORT void SetEventTap(EventCallback tap);
 
 EXPORT u16 GetEventSubCount(void);
 
-EXPORT void SubToEvent(const char* type, EventCallback callback);
+// payload size is fixed per type, registering same name again returns same id
+EXPORT EventType RegisterEventType(const char* name, const u16 payloadSize);
+
+EXPORT const char* GetEventTypeName(const EventType type);
+
+EXPORT u16 GetEventPayloadSize(const EventType type);
+
+// combine callback is only used by accumulate mode
+EXPORT void SetEventCoalesceMode(const EventType type, const EventCoalesceMode mode, EventCombineCallback combine);
+
+EXPORT void SubToEvent(const EventType type, EventCallback callback);
+
+EXPORT void UnsubToEvent(const EventType type, EventCallback callback);
+
+EXPORT void SubToEventBatch(const EventType type, EventBatchCallback callback);
+
+EXPORT void UnsubToEventBatch(const EventType type, EventBatchCallback callback);
 
-EXPORT void UnsubToEvent(const char* type, EventCallback callback);
+// size must match size type was registered with, payload can be null for types without one
+EXPORT void FireEvent(const EventType type, const void* p_payload, const u16 size);
 
-EXPORT void FireEvent(const char* type);
+// thread safe, event is moved to queue on next ProcessEvents, returns false if post queue is full
+// type must be registered on main thread before workers post it
+EXPORT b8 PostEvent(const EventType type, const void* p_payload, const u16 size);
 
-EXPORT void SetEventArgI32(const char* type, const u32 index, const char* key, const i32 value);
+// string based shims, they look name up on every call, so prefer ids on hot paths
+EXPORT EventType FindEventType(const char* name);
 
-EXPORT void SetEventArgF32(const char* type, const u32 index, const char* key, const f32 value);
+EXPORT void SubToEventByName(const char* name, EventCallback callback);
 
-EXPORT void SetEventArg(const char* type, const u32 index, const char* key, const EventArgValue value);
+EXPORT void UnsubToEventByName(const char* name, EventCallback callback);
 
-EXPORT EventArgValue GetEventArg(const Event* p_event, const char* key);
+EXPORT void FireEventByName(const char* name, const void* p_payload, const u16 size);
@@ -0,0 +1,255 @@
+#include "core/event_recorder.h"
+#include "core/assert.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+#include "platform/clock.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CHANNEL "Event Recorder"
+
+static b8 initialized = false;
+
+static EventRecorderMode recorderMode;
+static FILE* file = null;
+
+// frame counter, advanced by every update
+static u32 frame = 0;
+static u64 startTime = 0;
+static u64 eventCount = 0;
+
+// record mode: which types are recorded, and which type names were already written
+static b8 recordedTypes[MAX_EVENT_TYPE_COUNT];
+static b8 writtenTypes[MAX_EVENT_TYPE_COUNT];
+
+// replay mode: recorded id -> current id, and record that was read but not fired yet
+static EventType replayTypes[MAX_EVENT_TYPE_COUNT];
+static EventRecord pendingRecord;
+static u8 pendingPayload[MAX_EVENT_PAYLOAD_SIZE];
+static b8 hasPendingRecord = false;
+
+// replay mode: last recorded frame, 0 if recording has no end record
+static u32 endFrame = 0;
+
+static void RecordEvent(const Event* p_event);
+static b8 ReadNextEventRecord(void);
+
+b8 StartupEventRecorder(const EventRecorderMode mode, const char* path)
+{
+    PROFILE_FUNCTION();
+
+    // make sure system is not started
+    Assert(CHANNEL, initialized == false, "System Is Already Initialized");
+
+    // check params for invalid pointers
+    Assert(CHANNEL, path != null, "Invalid String Provided");
+
+    // open file and check for errors
+    file = fopen(path, mode == EVENT_RECORDER_MODE_RECORD ? "wb" : "rb");
+    if (!file)
+    {
+        LogError(CHANNEL, "File Not Opened {Path: %s}", path);
+        return false;
+    }
+
+    // reset state
+    recorderMode = mode;
+    frame = 0;
+    eventCount = 0;
+    startTime = GetClockNanoseconds();
+    memset(writtenTypes, 0, sizeof(writtenTypes));
+    memset(recordedTypes, 0, sizeof(recordedTypes));
+    memset(recordedTypes, true, EVENT_TYPE_BUILTIN_COUNT);
+    hasPendingRecord = false;
+    endFrame = 0;
+    for (u32 i = 0; i < MAX_EVENT_TYPE_COUNT; i++)
+    {
+        replayTypes[i] = INVALID_EVENT_TYPE;
+    }
+
+    // write header and start watching events
+    if (mode == EVENT_RECORDER_MODE_RECORD)
+    {
+        EventRecordingHeader header = { .version = EVENT_RECORDING_VERSION };
+        memcpy(header.magic, EVENT_RECORDING_MAGIC, sizeof(header.magic));
+        fwrite(&header, sizeof(header), 1, file);
+        SetEventTap(RecordEvent);
+    }
+    // read header, make sure file is recording this build understands
+    else
+    {
+        EventRecordingHeader header;
+        if (
+                fread(&header, sizeof(header), 1, file) != 1 ||
+                memcmp(header.magic, EVENT_RECORDING_MAGIC, sizeof(header.magic)) != 0 ||
+                header.version != EVENT_RECORDING_VERSION
+           )
+        {
+            LogError(CHANNEL, "Invalid Recording {Path: %s}", path);
+            fclose(file);
+            file = null;
+            return false;
+        }
+
+        // read first event ahead
+        hasPendingRecord = ReadNextEventRecord();
+    }
+
+    // track system startup
+    initialized = true;
+    LogSuccess(CHANNEL, "%s {Mode: %s, Path: %s}", SYSTEM_INITIALIZED_MESSAGE,
+            mode == EVENT_RECORDER_MODE_RECORD ? "Record" : "Replay", path);
+
+    // return success
+    return true;
+}
+
+void ShutdownEventRecorder(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
+
+    // stop watching events, and mark last frame so replay runs same number of frames
+    if (recorderMode == EVENT_RECORDER_MODE_RECORD)
+    {
+        SetEventTap(null);
+        EventRecord record = {
+            .timestamp = GetClockNanoseconds() - startTime,
+            .frame = frame,
+            .kind = EVENT_RECORD_KIND_END
+        };
+        fwrite(&record, sizeof(record), 1, file);
+    }
+
+    // close file
+    fclose(file);
+    file = null;
+
+    // track system shutdown
+    initialized = false;
+    LogSuccess(CHANNEL, "%s {Frames: %d, Events: %lu}", SYSTEM_TERMINATED_MESSAGE, frame, eventCount);
+}
+
+b8 UpdateEventRecorder(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, "System Is not Initialized Yet");
+
+    // start next frame
+    frame++;
+
+    // recording only needs frame number
+    if (recorderMode == EVENT_RECORDER_MODE_RECORD)
+    {
+        return true;
+    }
+
+    // fire every recorded event of this frame
+    while (hasPendingRecord && pendingRecord.frame <= frame)
+    {
+        FireEvent(replayTypes[pendingRecord.type], pendingPayload, pendingRecord.size);
+        eventCount++;
+        hasPendingRecord = ReadNextEventRecord();
+    }
+
+    // replay is over on last recorded frame, old recordings without end record end with last event
+    if (endFrame > 0)
+    {
+        return frame < endFrame;
+    }
+    return hasPendingRecord;
+}
+
+void SetEventTypeRecorded(const EventType type, const b8 isRecorded)
+{
+    // make sure type fits in table
+    Assert(CHANNEL, type < MAX_EVENT_TYPE_COUNT, "Invalid Event Type Provided");
+
+    recordedTypes[type] = isRecorded;
+}
+
+static void RecordEvent(const Event* p_event)
+{
+    // skip events game makes itself
+    if (!recordedTypes[p_event->type])
+    {
+        return;
+    }
+
+    // write type name first time type is seen, so replay can map ids by name
+    if (!writtenTypes[p_event->type])
+    {
+        EventRecord record = {
+            .frame = frame,
+            .type = p_event->type,
+            .kind = EVENT_RECORD_KIND_TYPE,
+            .size = p_event->size
+        };
+        char name[MAX_EVENT_TYPE_LENGTH] = {};
+        strcpy(name, GetEventTypeName(p_event->type));
+        fwrite(&record, sizeof(record), 1, file);
+        fwrite(name, sizeof(name), 1, file);
+        writtenTypes[p_event->type] = true;
+    }
+
+    // write event and its payload
+    EventRecord record = {
+        .timestamp = GetClockNanoseconds() - startTime,
+        .frame = frame,
+        .type = p_event->type,
+        .kind = EVENT_RECORD_KIND_EVENT,
+        .size = p_event->size
+    };
+    fwrite(&record, sizeof(record), 1, file);
+    fwrite(p_event->payload, p_event->size, 1, file);
+    eventCount++;
+}
+
+static b8 ReadNextEventRecord(void)
+{
+    // loop until event record or end of file
+    while (fread(&pendingRecord, sizeof(pendingRecord), 1, file) == 1)
+    {
+        // make sure record fits in tables
+        if (pendingRecord.type >= MAX_EVENT_TYPE_COUNT || pendingRecord.size > MAX_EVENT_PAYLOAD_SIZE)
+        {
+            LogError(CHANNEL, "Corrupted Record {Frame: %d, Type: %d}", pendingRecord.frame, pendingRecord.type);
+            return false;
+        }
+
+        // nothing follows end record
+        if (pendingRecord.kind == EVENT_RECORD_KIND_END)
+        {
+            endFrame = pendingRecord.frame;
+            return false;
+        }
+
+        // map recorded type id to id of this run, registering type if nobody did yet
+        if (pendingRecord.kind == EVENT_RECORD_KIND_TYPE)
+        {
+            char name[MAX_EVENT_TYPE_LENGTH];
+            if (fread(name, sizeof(name), 1, file) != 1)
+            {
+                break;
+            }
+            name[MAX_EVENT_TYPE_LENGTH - 1] = '\0';
+            replayTypes[pendingRecord.type] = RegisterEventType(name, pendingRecord.size);
+            continue;
+        }
+
+        // read payload, skip events whose type could not be mapped
+        if (pendingRecord.size > 0 && fread(pendingPayload, pendingRecord.size, 1, file) != 1)
+        {
+            break;
+        }
+        if (replayTypes[pendingRecord.type] == INVALID_EVENT_TYPE)
+        {
+            LogWarning(CHANNEL, "Event Of Unknown Type Skipped {Frame: %d, Type: %d}", pendingRecord.frame, pendingRecord.type);
+            continue;
+        }
+
+        return true;
+    }
+
+    return false;
+}
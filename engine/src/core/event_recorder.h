@@ -0,0 +1,46 @@
+#pragma once
+
+#include "defines.h"
+#include "core/event.h"
+
+#define EVENT_RECORDING_MAGIC "CEVR"
+#define EVENT_RECORDING_VERSION 2
+
+typedef enum EventRecorderMode {
+    EVENT_RECORDER_MODE_RECORD,         // write every dispatched event of recorded types to file
+    EVENT_RECORDER_MODE_REPLAY          // fire events from file instead of window
+} EventRecorderMode;
+
+typedef enum EventRecordKind {
+    EVENT_RECORD_KIND_TYPE,             // followed by type name, maps recorded id to name
+    EVENT_RECORD_KIND_EVENT,            // followed by payload
+    EVENT_RECORD_KIND_END               // last record, frame is last recorded frame
+} EventRecordKind;
+
+// file layout: [file header][record][record]...
+typedef struct EventRecordingHeader {
+    char magic[4];
+    u32 version;
+} EventRecordingHeader;
+
+typedef struct EventRecord {
+    u64 timestamp;                      // nanoseconds since recording started
+    u32 frame;
+    u16 type;
+    u8 kind;
+    u8 size;                            // payload size, or type payload size for type records
+} EventRecord;
+
+// must be started after event system, and shutdown before it
+EXPORT b8 StartupEventRecorder(const EventRecorderMode mode, const char* path);
+
+EXPORT void ShutdownEventRecorder(void);
+
+// call once per frame before ProcessEvents, when replaying it fires recorded events of frame
+// returns false on last recorded frame
+EXPORT b8 UpdateEventRecorder(void);
+
+// only types that enter from outside of game are recorded, by default built in window types
+// events fired by callbacks are made again on replay, so recording them would fire them twice
+// startup resets types to defaults, so call it after startup
+EXPORT void SetEventTypeRecorded(const EventType type, const b8 isRecorded);
@@ -0,0 +1,99 @@
+#include "core/frame_allocator.h"
+#include "core/linear_allocator.h"
+#include "core/memory.h"
+#include "core/assert.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+
+#define CHANNEL "Frame Allocator"
+
+static b8 initialized = false;
+
+// memory requested in frame N lives in buffers[N % count] and stays valid until frame N + count
+static LinearAllocator buffers[FRAME_ALLOCATOR_BUFFER_COUNT];
+static u8 current = 0;
+
+b8 StartupFrameAllocator(const u32 size)
+{
+    PROFILE_FUNCTION();
+
+    // make sure system is not started
+    Assert(CHANNEL, initialized == false, "System Is Already Initialized");
+
+    // create linear allocator for every buffered frame
+    for (u8 i = 0; i < FRAME_ALLOCATOR_BUFFER_COUNT; i++)
+    {
+        if (!CreateLinearAllocator(&buffers[i], size, MEMORY_TAG_FRAME))
+        {
+            LogError(CHANNEL, "Linear Allocator Not Created");
+
+            // destroy already created allocators
+            for (u8 j = 0; j < i; j++)
+            {
+                DestroyLinearAllocator(&buffers[j]);
+            }
+            return false;
+        }
+    }
+
+    // start from first buffer
+    current = 0;
+
+    // track system startup
+    initialized = true;
+    LogSuccess(CHANNEL, SYSTEM_INITIALIZED_MESSAGE);
+
+    // return success
+    return true;
+}
+
+void ShutdownFrameAllocator(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // destroy allocators
+    for (u8 i = 0; i < FRAME_ALLOCATOR_BUFFER_COUNT; i++)
+    {
+        DestroyLinearAllocator(&buffers[i]);
+    }
+
+    // track system shutdown
+    initialized = false;
+    LogSuccess(CHANNEL, SYSTEM_TERMINATED_MESSAGE);
+}
+
+void* RequestFrameMemory(const u32 size)
+{
+    return RequestFrameMemoryAligned(size, DEFAULT_MEMORY_ALIGNMENT);
+}
+
+void* RequestFrameMemoryAligned(const u32 size, const u32 alignment)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // bump current frame buffer
+    return RequestLinearAllocatorMemory(&buffers[current], size, alignment);
+}
+
+void SwapFrameAllocator(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // move to next buffer
+    current = (current + 1) % FRAME_ALLOCATOR_BUFFER_COUNT;
+
+    // next buffer holds oldest frame data, which is not needed anymore
+    ResetLinearAllocator(&buffers[current]);
+}
+
+u32 GetFrameMemoryUsage(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // return memory used by current frame
+    return buffers[current].used;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "defines.h"
+
+#define FRAME_ALLOCATOR_BUFFER_COUNT 2
+
+EXPORT b8 StartupFrameAllocator(const u32 size);
+
+EXPORT void ShutdownFrameAllocator(void);
+
+EXPORT void* RequestFrameMemory(const u32 size);
+
+EXPORT void* RequestFrameMemoryAligned(const u32 size, const u32 alignment);
+
+void SwapFrameAllocator(void);
+
+EXPORT u32 GetFrameMemoryUsage(void);
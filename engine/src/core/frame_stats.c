@@ -0,0 +1,265 @@
+#include "core/frame_stats.h"
+#include "core/assert.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+#include "platform/clock.h"
+#include <string.h>
+
+#define CHANNEL "Frame Stats"
+
+#define SUB_BUCKET_HALF_COUNT (1 << (FRAME_STATS_SUB_BUCKET_BITS - 1))
+
+static b8 initialized = false;
+
+static const char* phaseNames[] =
+{ "Events", "Update", "Render", "Frame" };
+
+// histograms are fixed size, recording never allocates
+static FrameHistogram slices[FRAME_STATS_SLICE_COUNT][FRAME_PHASE_COUNT];
+static u32 currentSlice = 0;
+static u64 sliceStart = 0;
+static u64 sliceDuration = 0;
+
+static u64 phaseStarts[FRAME_PHASE_COUNT];
+static u64 logInterval = 0;
+static u64 lastLogTime = 0;
+
+static u32 GetBucketIndex(const u64 value);
+static u64 GetBucketValue(const u32 index);
+static void RecordFrameValue(const FramePhase phase, const u64 value);
+static void AdvanceFrameSlices(const u64 time);
+static void MergeFrameHistograms(const FramePhase phase, FrameHistogram* p_histogram);
+static u64 GetHistogramPercentile(const FrameHistogram* p_histogram, const f64 percentile);
+
+b8 StartupFrameStats(const u64 windowNanoseconds, const u64 logIntervalNanoseconds)
+{
+    PROFILE_FUNCTION();
+
+    // make sure system is not started
+    Assert(CHANNEL, initialized == false, "System Is Already Initialized");
+    Assert(CHANNEL, windowNanoseconds >= FRAME_STATS_SLICE_COUNT, "Invalid Window Provided");
+
+    // zero out histograms
+    memset(slices, 0, sizeof(slices));
+    memset(phaseStarts, 0, sizeof(phaseStarts));
+    currentSlice = 0;
+
+    // window is split in equal slices
+    sliceDuration = windowNanoseconds / FRAME_STATS_SLICE_COUNT;
+    sliceStart = GetClockNanoseconds();
+    logInterval = logIntervalNanoseconds;
+    lastLogTime = sliceStart;
+
+    // track system startup
+    initialized = true;
+    LogSuccess(CHANNEL, SYSTEM_INITIALIZED_MESSAGE);
+
+    // return success
+    return true;
+}
+
+void ShutdownFrameStats(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // track system shutdown
+    initialized = false;
+    LogSuccess(CHANNEL, SYSTEM_TERMINATED_MESSAGE);
+}
+
+void BeginFrameStats(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    BeginFramePhase(FRAME_PHASE_FRAME);
+}
+
+void EndFrameStats(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // record whole frame
+    u64 time = GetClockNanoseconds();
+    RecordFrameValue(FRAME_PHASE_FRAME, time - phaseStarts[FRAME_PHASE_FRAME]);
+
+    // log summary when interval passes, before slices move so it covers full window
+    if (logInterval > 0 && time - lastLogTime >= logInterval)
+    {
+        LogFrameStats();
+        lastLogTime = time;
+    }
+
+    // start new slice if current one is over
+    AdvanceFrameSlices(time);
+}
+
+void BeginFramePhase(const FramePhase phase)
+{
+    // engine marks phases even when nobody collects them
+    if (!initialized)
+    {
+        return;
+    }
+
+    phaseStarts[phase] = GetClockNanoseconds();
+}
+
+void EndFramePhase(const FramePhase phase)
+{
+    // engine marks phases even when nobody collects them
+    if (!initialized)
+    {
+        return;
+    }
+
+    RecordFrameValue(phase, GetClockNanoseconds() - phaseStarts[phase]);
+}
+
+FramePhaseStats GetFramePhaseStats(const FramePhase phase)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // merge window once and read every percentile from it
+    FrameHistogram histogram;
+    MergeFrameHistograms(phase, &histogram);
+    return (FramePhaseStats){
+        .count = histogram.count,
+        .p50 = GetHistogramPercentile(&histogram, 50.0),
+        .p95 = GetHistogramPercentile(&histogram, 95.0),
+        .p99 = GetHistogramPercentile(&histogram, 99.0),
+        .max = histogram.max
+    };
+}
+
+u64 GetFramePhasePercentile(const FramePhase phase, const f64 percentile)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    FrameHistogram histogram;
+    MergeFrameHistograms(phase, &histogram);
+    return GetHistogramPercentile(&histogram, percentile);
+}
+
+void LogFrameStats(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // log every phase that was recorded in window, times in milliseconds
+    // success level stays compiled in release and profile builds, where frame times matter most
+    for (u32 i = 0; i < FRAME_PHASE_COUNT; i++)
+    {
+        FramePhaseStats stats = GetFramePhaseStats(i);
+        if (stats.count == 0)
+        {
+            continue;
+        }
+        LogSuccess(CHANNEL, "%s {P50: %.3fms, P95: %.3fms, P99: %.3fms, Max: %.3fms, Count: %lu}", phaseNames[i],
+                stats.p50 / 1e6, stats.p95 / 1e6, stats.p99 / 1e6, stats.max / 1e6, stats.count);
+    }
+}
+
+static u32 GetBucketIndex(const u64 value)
+{
+    // small values get bucket each
+    if (value < 2 * SUB_BUCKET_HALF_COUNT)
+    {
+        return value;
+    }
+
+    // keep top bits of value, shift tells which power of two it is in
+    u32 shift = 63 - __builtin_clzll(value) - (FRAME_STATS_SUB_BUCKET_BITS - 1);
+    u32 index = (shift << (FRAME_STATS_SUB_BUCKET_BITS - 1)) + (u32)(value >> shift);
+    return index < FRAME_STATS_BUCKET_COUNT ? index : FRAME_STATS_BUCKET_COUNT - 1;
+}
+
+static u64 GetBucketValue(const u32 index)
+{
+    // small values get bucket each
+    if (index < 2 * SUB_BUCKET_HALF_COUNT)
+    {
+        return index;
+    }
+
+    // highest value that lands in bucket
+    u32 shift = (index >> (FRAME_STATS_SUB_BUCKET_BITS - 1)) - 1;
+    u64 subBucket = index - (shift << (FRAME_STATS_SUB_BUCKET_BITS - 1));
+    return ((subBucket + 1) << shift) - 1;
+}
+
+static void RecordFrameValue(const FramePhase phase, const u64 value)
+{
+    FrameHistogram* p_histogram = &slices[currentSlice][phase];
+    p_histogram->buckets[GetBucketIndex(value)]++;
+    p_histogram->count++;
+    p_histogram->max = value > p_histogram->max ? value : p_histogram->max;
+}
+
+static void AdvanceFrameSlices(const u64 time)
+{
+    // clear one slice for every slice duration passed, long stalls clear whole window
+    for (u32 i = 0; i < FRAME_STATS_SLICE_COUNT && time - sliceStart >= sliceDuration; i++)
+    {
+        currentSlice = (currentSlice + 1) % FRAME_STATS_SLICE_COUNT;
+        memset(slices[currentSlice], 0, sizeof(slices[currentSlice]));
+        sliceStart += sliceDuration;
+    }
+
+    // stall was longer than window, start counting from now
+    if (time - sliceStart >= sliceDuration)
+    {
+        sliceStart = time;
+    }
+}
+
+static void MergeFrameHistograms(const FramePhase phase, FrameHistogram* p_histogram)
+{
+    // add up every slice of window
+    memset(p_histogram, 0, sizeof(FrameHistogram));
+    for (u32 i = 0; i < FRAME_STATS_SLICE_COUNT; i++)
+    {
+        const FrameHistogram* p_slice = &slices[i][phase];
+        if (p_slice->count == 0)
+        {
+            continue;
+        }
+        for (u32 j = 0; j < FRAME_STATS_BUCKET_COUNT; j++)
+        {
+            p_histogram->buckets[j] += p_slice->buckets[j];
+        }
+        p_histogram->count += p_slice->count;
+        p_histogram->max = p_slice->max > p_histogram->max ? p_slice->max : p_histogram->max;
+    }
+}
+
+static u64 GetHistogramPercentile(const FrameHistogram* p_histogram, const f64 percentile)
+{
+    // nothing recorded
+    if (p_histogram->count == 0)
+    {
+        return 0;
+    }
+
+    // walk buckets until enough values are behind
+    f64 rank = percentile / 100.0 * p_histogram->count;
+    u64 target = (u64)rank < rank ? (u64)rank + 1 : (u64)rank;
+    target = target > 0 ? target : 1;
+    u64 seen = 0;
+    for (u32 i = 0; i < FRAME_STATS_BUCKET_COUNT; i++)
+    {
+        seen += p_histogram->buckets[i];
+        if (seen >= target)
+        {
+            // bucket bound can be above anything recorded
+            u64 value = GetBucketValue(i);
+            return value < p_histogram->max ? value : p_histogram->max;
+        }
+    }
+
+    return p_histogram->max;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "defines.h"
+
+// log-linear histogram, every power of two is split into 32 linear buckets, so values are within ~3%
+// values are nanoseconds, bucket count covers up to ~68 seconds, longer values land in last bucket
+#define FRAME_STATS_SUB_BUCKET_BITS 6
+#define FRAME_STATS_BUCKET_COUNT 1024
+
+// rolling window is kept as slices, oldest slice is dropped when new one starts
+#define FRAME_STATS_SLICE_COUNT 4
+
+typedef enum FramePhase {
+    FRAME_PHASE_EVENTS,
+    FRAME_PHASE_UPDATE,
+    FRAME_PHASE_RENDER,
+    FRAME_PHASE_FRAME,                  // whole frame, from BeginFrameStats to EndFrameStats
+    FRAME_PHASE_COUNT
+} FramePhase;
+
+typedef struct FrameHistogram {
+    u32 buckets[FRAME_STATS_BUCKET_COUNT];
+    u64 count;
+    u64 max;
+} FrameHistogram;
+
+// nanoseconds over rolling window
+typedef struct FramePhaseStats {
+    u64 count;
+    u64 p50;
+    u64 p95;
+    u64 p99;
+    u64 max;
+} FramePhaseStats;
+
+// stats cover last window of time, summary is logged every log interval, 0 disables it
+EXPORT b8 StartupFrameStats(const u64 windowNanoseconds, const u64 logIntervalNanoseconds);
+
+EXPORT void ShutdownFrameStats(void);
+
+// frame and phase marks are meant for main thread only
+EXPORT void BeginFrameStats(void);
+
+EXPORT void EndFrameStats(void);
+
+EXPORT void BeginFramePhase(const FramePhase phase);
+
+EXPORT void EndFramePhase(const FramePhase phase);
+
+EXPORT FramePhaseStats GetFramePhaseStats(const FramePhase phase);
+
+// percentile in range 0 - 100, returns upper bound of bucket it falls in
+EXPORT u64 GetFramePhasePercentile(const FramePhase phase, const f64 percentile);
+
+EXPORT void LogFrameStats(void);
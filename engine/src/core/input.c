@@ -0,0 +1,219 @@
+#include "core/input.h"
+#include "core/assert.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+#include "platform/clock.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#define CHANNEL "Input"
+
+// set in shared index when it holds snapshot reader has not taken yet
+#define SNAPSHOT_FRESH 0x4
+#define SNAPSHOT_INDEX_MASK 0x3
+
+static b8 initialized = false;
+
+// triple buffer, writer fills back, reader holds front, they trade thro shared index without ever waiting
+static InputState snapshots[3];
+static u8 back = 0;
+static _Atomic u8 shared = 1;
+static u8 front = 2;
+
+// writer keeps changing this between publishes
+static InputState current;
+
+// snapshot of frame before, per frame edges and deltas are differences against it
+static InputState previous;
+
+// writer side bookkeeping, not part of snapshots
+static b8 isChanged = false;            // set by every writer call, publish skips when clear
+static b8 hasRawMotion = false;         // once raw motion comes, position changes stop counting as motion
+static f32 motionRemainderX = 0;        // raw motion below whole unit, waits for next call
+static f32 motionRemainderY = 0;
+
+b8 StartupInputSystem(void)
+{
+    PROFILE_FUNCTION();
+
+    // make sure system is not started
+    Assert(CHANNEL, initialized == false, "System Is Already Initialized");
+
+    // start from nothing pressed
+    memset(snapshots, 0, sizeof(snapshots));
+    memset(&current, 0, sizeof(current));
+    memset(&previous, 0, sizeof(previous));
+    isChanged = false;
+    hasRawMotion = false;
+    motionRemainderX = 0;
+    motionRemainderY = 0;
+    back = 0;
+    atomic_store(&shared, 1);
+    front = 2;
+
+    // track system startup
+    initialized = true;
+    LogSuccess(CHANNEL, SYSTEM_INITIALIZED_MESSAGE);
+    return true;
+}
+
+void ShutdownInputSystem(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // track system shutdown
+    initialized = false;
+    LogSuccess(CHANNEL, SYSTEM_TERMINATED_MESSAGE);
+}
+
+void SetInputKey(const u32 keycode, const b8 isDown, const u32 time)
+{
+    // ignore keycodes that do not fit bitset
+    if (keycode >= INPUT_KEY_COUNT)
+    {
+        return;
+    }
+
+    // count presses, auto repeat sends press without release, so it counts too
+    u64 bit = 1ull << (keycode % 64);
+    if (isDown)
+    {
+        current.keys[keycode / 64] |= bit;
+        current.keyPresses[keycode]++;
+    }
+    else
+    {
+        current.keys[keycode / 64] &= ~bit;
+    }
+    current.keyTimes[keycode] = time;
+    isChanged = true;
+}
+
+void SetInputButton(const u8 button, const b8 isDown, const u32 time)
+{
+    // ignore buttons that do not fit bitset
+    if (button >= INPUT_BUTTON_COUNT)
+    {
+        return;
+    }
+
+    if (isDown)
+    {
+        current.buttons |= 1u << button;
+        current.buttonPresses[button]++;
+    }
+    else
+    {
+        current.buttons &= ~(1u << button);
+    }
+    current.buttonTimes[button] = time;
+    isChanged = true;
+}
+
+void SetInputMousePosition(const i32 x, const i32 y, const u32 time)
+{
+    // position changes count as motion too, unless raw motion already does, then it would count twice
+    if (!hasRawMotion)
+    {
+        current.mouseMotionX += x - current.mouseX;
+        current.mouseMotionY += y - current.mouseY;
+    }
+    current.mouseX = x;
+    current.mouseY = y;
+    current.mouseTime = time;
+    isChanged = true;
+}
+
+void MoveInputMouse(const f32 deltaX, const f32 deltaY, const u32 time)
+{
+    // whole units go to motion, rest is carried, so slow motion is not rounded away
+    motionRemainderX += deltaX;
+    motionRemainderY += deltaY;
+    i32 x = (i32)motionRemainderX;
+    i32 y = (i32)motionRemainderY;
+    motionRemainderX -= x;
+    motionRemainderY -= y;
+
+    current.mouseMotionX += x;
+    current.mouseMotionY += y;
+    current.mouseTime = time;
+    hasRawMotion = true;
+    isChanged = true;
+}
+
+void PublishInput(void)
+{
+    // batches that changed nothing, like focus changes or wakes, leave reader's snapshot alone
+    if (!isChanged)
+    {
+        return;
+    }
+    isChanged = false;
+
+    // fill back snapshot
+    current.sequence++;
+    current.timestamp = GetClockNanoseconds();
+    memcpy(&snapshots[back], &current, sizeof(InputState));
+
+    // swap it with shared one, if reader did not take shared one yet, it is simply overwritten by newer
+    back = atomic_exchange_explicit(&shared, back | SNAPSHOT_FRESH, memory_order_acq_rel) & SNAPSHOT_INDEX_MASK;
+}
+
+void UpdateInput(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // snapshot held so far becomes frame before
+    memcpy(&previous, &snapshots[front], sizeof(InputState));
+
+    // take newest snapshot if writer published since last frame, otherwise keep current one
+    if (atomic_load_explicit(&shared, memory_order_relaxed) & SNAPSHOT_FRESH)
+    {
+        front = atomic_exchange_explicit(&shared, front, memory_order_acq_rel) & SNAPSHOT_INDEX_MASK;
+    }
+}
+
+const InputState* GetInputState(void)
+{
+    return &snapshots[front];
+}
+
+b8 IsKeyDown(const u32 keycode)
+{
+    return keycode < INPUT_KEY_COUNT && (snapshots[front].keys[keycode / 64] >> (keycode % 64)) & 1;
+}
+
+b8 WasKeyPressed(const u32 keycode)
+{
+    return keycode < INPUT_KEY_COUNT && snapshots[front].keyPresses[keycode] != previous.keyPresses[keycode];
+}
+
+b8 IsButtonDown(const u8 button)
+{
+    return button < INPUT_BUTTON_COUNT && (snapshots[front].buttons >> button) & 1;
+}
+
+b8 WasButtonPressed(const u8 button)
+{
+    return button < INPUT_BUTTON_COUNT && snapshots[front].buttonPresses[button] != previous.buttonPresses[button];
+}
+
+void GetMousePosition(i32* p_x, i32* p_y)
+{
+    // check params for invalid pointers
+    Assert(CHANNEL, p_x != null && p_y != null, "Invalid Pointer Provided");
+
+    *p_x = snapshots[front].mouseX;
+    *p_y = snapshots[front].mouseY;
+}
+
+void GetMouseDelta(i32* p_deltaX, i32* p_deltaY)
+{
+    // check params for invalid pointers
+    Assert(CHANNEL, p_deltaX != null && p_deltaY != null, "Invalid Pointer Provided");
+
+    *p_deltaX = snapshots[front].mouseMotionX - previous.mouseMotionX;
+    *p_deltaY = snapshots[front].mouseMotionY - previous.mouseMotionY;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "defines.h"
+
+// x keycodes fit in byte, buttons keep x numbering, 1 is left, 4 and 5 are wheel
+#define INPUT_KEY_COUNT 256
+#define INPUT_BUTTON_COUNT 16
+
+// immutable copy of input, taken by whatever thread owns window events and read by main thread
+typedef struct InputState {
+    u64 keys[INPUT_KEY_COUNT / 64];     // bit per keycode, set while key is down
+    u8 keyPresses[INPUT_KEY_COUNT];     // wrapping press count, so taps shorter than frame are not lost
+    u32 keyTimes[INPUT_KEY_COUNT];      // server time of last press or release, milliseconds
+    u16 buttons;                        // bit per button, set while button is down
+    u8 buttonPresses[INPUT_BUTTON_COUNT];
+    u32 buttonTimes[INPUT_BUTTON_COUNT];
+    i32 mouseX;
+    i32 mouseY;
+    i64 mouseMotionX;                   // total motion since startup, frame delta is difference of two snapshots
+    i64 mouseMotionY;
+    u32 mouseTime;
+    u64 sequence;                       // bumped on every publish
+    u64 timestamp;                      // clock nanoseconds when snapshot was published
+} InputState;
+
+EXPORT b8 StartupInputSystem(void);
+
+EXPORT void ShutdownInputSystem(void);
+
+// writer side, only thread that owns window events calls these, changes are seen after next publish
+EXPORT void SetInputKey(const u32 keycode, const b8 isDown, const u32 time);
+
+EXPORT void SetInputButton(const u8 button, const b8 isDown, const u32 time);
+
+// position changes count as motion until first raw motion arrives, after that only raw motion does
+EXPORT void SetInputMousePosition(const i32 x, const i32 y, const u32 time);
+
+// relative motion that does not come with position, like raw device motion, fractions are carried to next call
+EXPORT void MoveInputMouse(const f32 deltaX, const f32 deltaY, const u32 time);
+
+// copies writer state into free snapshot and hands it to reader without locks, does nothing if nothing changed
+EXPORT void PublishInput(void);
+
+// reader side, main thread takes newest published snapshot at start of frame and polls it until next one
+EXPORT void UpdateInput(void);
+
+EXPORT const InputState* GetInputState(void);
+
+EXPORT b8 IsKeyDown(const u32 keycode);
+
+// true if key went down at least once since previous frame, even if it is already up again
+EXPORT b8 WasKeyPressed(const u32 keycode);
+
+EXPORT b8 IsButtonDown(const u8 button);
+
+EXPORT b8 WasButtonPressed(const u8 button);
+
+EXPORT void GetMousePosition(i32* p_x, i32* p_y);
+
+// motion since previous frame
+EXPORT void GetMouseDelta(i32* p_deltaX, i32* p_deltaY);
@@ -0,0 +1,91 @@
+#include "core/linear_allocator.h"
+#include "core/memory.h"
+#include "core/assert.h"
+#include "core/logger.h"
+
+#define CHANNEL "Linear Allocator"
+
+b8 CreateLinearAllocator(LinearAllocator* p_allocator, const u32 size, const MemoryTag tag)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+
+    // make sure size is greater than 0
+    Assert(CHANNEL, size > 0, "Invalid Size Provided");
+
+    // allocate memory on heap
+    p_allocator->memory = AllocateMemory(size, tag);
+
+    // check for allocation errors
+    if (!p_allocator->memory)
+    {
+        LogError(CHANNEL, "Memory Allocation Failed");
+        return false;
+    }
+
+    // init attributes
+    p_allocator->size = size;
+    p_allocator->used = 0;
+    p_allocator->tag = tag;
+
+    // return success as default
+    LogSuccess(CHANNEL, "Allocator Created");
+    return true;
+}
+
+void DestroyLinearAllocator(LinearAllocator* p_allocator)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->memory != null, "Invalid Pointer Provided");
+
+    // free memory
+    FreeMemory(p_allocator->memory, p_allocator->size, p_allocator->tag);
+    LogSuccess(CHANNEL, "Allocator Destroyed {Size: %dB}", p_allocator->size);
+
+    // zero out stuff
+    p_allocator->memory = null;
+    p_allocator->used = 0;
+    p_allocator->size = 0;
+}
+
+void* RequestLinearAllocatorMemory(LinearAllocator* p_allocator, const u32 size, const u32 alignment)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->memory != null, "Allocator Is Not Created Yet");
+
+    // make sure size is greater than 0
+    Assert(CHANNEL, size > 0, "Invalid Size Provided");
+
+    // make sure alignment is power of two
+    Assert(CHANNEL, alignment > 0 && (alignment & (alignment - 1)) == 0, "Invalid Alignment Provided");
+
+    // align marker relative to real address, so base alignment does not matter
+    uintptr_t base = (uintptr_t)p_allocator->memory;
+    u32 offset = (u32)(AlignUp(base + p_allocator->used, (uintptr_t)alignment) - base);
+
+    // check if allocator is able to allocate that much memory
+    if (offset > p_allocator->size || size > p_allocator->size - offset)
+    {
+        LogError(CHANNEL, "Out Of Memory {Size: %dB, Used: %dB, Requested: %dB}",
+                p_allocator->size, p_allocator->used, size);
+        return null;
+    }
+
+    // move marker
+    p_allocator->used = offset + size;
+
+    // return requested memory
+    return (char*)p_allocator->memory + offset;
+}
+
+void ResetLinearAllocator(LinearAllocator* p_allocator)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->memory != null, "Allocator Is Not Created Yet");
+
+    // move marker back to the start
+    p_allocator->used = 0;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "defines.h"
+#include "core/memory.h"
+
+typedef struct LinearAllocator {
+    u32 size;
+    u32 used;
+    MemoryTag tag;
+    void* memory;
+} LinearAllocator;
+
+b8 CreateLinearAllocator(LinearAllocator* p_allocator, const u32 size, const MemoryTag tag);
+
+void DestroyLinearAllocator(LinearAllocator* p_allocator);
+
+void* RequestLinearAllocatorMemory(LinearAllocator* p_allocator, const u32 size, const u32 alignment);
+
+void ResetLinearAllocator(LinearAllocator* p_allocator);
@@ -0,0 +1,213 @@
+#include "core/log_file_sink.h"
+#include "core/assert.h"
+#include "core/log_record.h"
+#include "platform/clock.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CHANNEL "Log File Sink"
+
+// longest line escaping can make, every channel and message byte may become \u00XX
+#define MAX_LOG_FILE_LINE_LENGTH (256 + (LOG_MAX_CHANNEL_LENGTH + LOG_MAX_MESSAGE_LENGTH + LOG_RECORD_MAX_STRING_LENGTH) * 6)
+
+static void WriteLogFileSink(void* p_data, const LogEntry* p_entry);
+static b8 RotateLogFile(LogFileSink* p_sink);
+static void ShiftLogFiles(const LogFileSink* p_sink);
+static u32 EscapeJsonString(char* p_text, const u32 capacity, const char* string, const u32 length);
+
+b8 CreateLogFileSink(LogFileSink* p_sink, const char* path, const u64 fileSize, const u32 fileCount, const LogFileFormat format)
+{
+    // check params for invalid pointers
+    Assert(CHANNEL, p_sink != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, path != null, "Invalid String Provided");
+
+    // make sure settings are valid
+    Assert(CHANNEL, strlen(path) + 12 < LOG_FILE_MAX_PATH_LENGTH, "Too Long Path Provided");
+    Assert(CHANNEL, fileSize > MAX_LOG_FILE_LINE_LENGTH, "Too Small File Size Provided");
+    Assert(CHANNEL, fileCount > 0, "Invalid File Count Provided");
+
+    // store settings
+    strcpy(p_sink->path, path);
+    p_sink->fileSize = fileSize;
+    p_sink->fileCount = fileCount;
+    p_sink->format = format;
+    p_sink->wallClockOffset = GetWallClockNanoseconds() - GetClockNanoseconds();
+    p_sink->used = 0;
+
+    // keep log of previous run, it may still end with zero tail if that run crashed
+    if (FileExists(path))
+    {
+        if (!TrimFileZeroTail(path))
+        {
+            LogWarning(CHANNEL, "Previous Log File Not Trimmed {Path: %s}", path);
+        }
+        ShiftLogFiles(p_sink);
+    }
+
+    // map first file
+    if (!CreateFileMap(&p_sink->map, path, fileSize))
+    {
+        LogError(CHANNEL, "Log File Not Created {Path: %s}", path);
+        return false;
+    }
+
+    // return success as default
+    LogSuccess(CHANNEL, "Sink Created {Path: %s, File Size: %luB, Files: %d, Format: %s}",
+            path, fileSize, fileCount, format == LOG_FILE_FORMAT_JSON ? "Json" : "Text");
+    return true;
+}
+
+void DestroyLogFileSink(LogFileSink* p_sink)
+{
+    // check params for invalid pointers
+    Assert(CHANNEL, p_sink != null, "Invalid Pointer Provided");
+
+    // cut file to what was written
+    if (p_sink->map.memory)
+    {
+        DestroyFileMap(&p_sink->map, p_sink->used);
+    }
+
+    LogSuccess(CHANNEL, "Sink Destroyed {Path: %s}", p_sink->path);
+}
+
+LogSink GetLogFileSink(LogFileSink* p_sink, const u8 flags)
+{
+    // mapped memory needs no flushing, kernel writes it back even if process crashes
+    return (LogSink){
+        .Write = WriteLogFileSink,
+        .Flush = null,
+        .p_data = p_sink,
+        .flags = flags
+    };
+}
+
+static void WriteLogFileSink(void* p_data, const LogEntry* p_entry)
+{
+    LogFileSink* p_sink = p_data;
+
+    // file could not be rotated before
+    if (!p_sink->map.memory)
+    {
+        return;
+    }
+
+    // unix time split in seconds and microseconds
+    u64 time = p_entry->timestamp + p_sink->wallClockOffset;
+    u64 seconds = time / 1000000000;
+    u64 microseconds = time % 1000000000 / 1000;
+
+    // format line
+    char line[MAX_LOG_FILE_LINE_LENGTH];
+    u32 length = 0;
+    const char* level = GetLogVerbosityName(p_entry->verbosity);
+    if (p_sink->format == LOG_FILE_FORMAT_JSON)
+    {
+        length = snprintf(line, sizeof(line), "{\"time\":%lu.%06lu,\"level\":\"%s\",\"channel\":\"", seconds, microseconds, level);
+        length += EscapeJsonString(line + length, sizeof(line) - length, p_entry->channel, strlen(p_entry->channel));
+        length += snprintf(line + length, sizeof(line) - length, "\",\"message\":\"");
+        length += EscapeJsonString(line + length, sizeof(line) - length, p_entry->message, p_entry->length);
+        length += snprintf(line + length, sizeof(line) - length, "\"}\n");
+    }
+    else
+    {
+        length = snprintf(line, sizeof(line), "[%lu.%06lu] [%s] %s: %.*s\n",
+                seconds, microseconds, level, p_entry->channel, (int)p_entry->length, p_entry->message);
+    }
+    length = length < sizeof(line) ? length : sizeof(line) - 1;
+
+    // rotate if line does not fit anymore
+    if (p_sink->used + length > p_sink->fileSize && !RotateLogFile(p_sink))
+    {
+        return;
+    }
+
+    // copy line into mapped file
+    memcpy((char*)p_sink->map.memory + p_sink->used, line, length);
+    p_sink->used += length;
+}
+
+static b8 RotateLogFile(LogFileSink* p_sink)
+{
+    // close full file
+    DestroyFileMap(&p_sink->map, p_sink->used);
+    p_sink->used = 0;
+
+    // make room for fresh file
+    ShiftLogFiles(p_sink);
+
+    // map fresh file, with single file count it replaces old one
+    if (!CreateFileMap(&p_sink->map, p_sink->path, p_sink->fileSize))
+    {
+        LogError(CHANNEL, "Log File Not Rotated {Path: %s}", p_sink->path);
+        return false;
+    }
+
+    return true;
+}
+
+static void ShiftLogFiles(const LogFileSink* p_sink)
+{
+    // shift older files, path.n - 1 -> path.n ... path -> path.1
+    char from[LOG_FILE_MAX_PATH_LENGTH];
+    char to[LOG_FILE_MAX_PATH_LENGTH];
+    for (u32 i = p_sink->fileCount - 1; i > 0; i--)
+    {
+        if (i == 1)
+        {
+            strcpy(from, p_sink->path);
+        }
+        else
+        {
+            snprintf(from, sizeof(from), "%s.%u", p_sink->path, i - 1);
+        }
+        snprintf(to, sizeof(to), "%s.%u", p_sink->path, i);
+
+        // files that were never written are missing, that is fine
+        if (FileExists(from) && !RenameFile(from, to))
+        {
+            LogWarning(CHANNEL, "Log File Not Renamed {From: %s, To: %s}", from, to);
+        }
+    }
+}
+
+static u32 EscapeJsonString(char* p_text, const u32 capacity, const char* string, const u32 length)
+{
+    u32 written = 0;
+
+    // loop thro characters, leave space for longest escape
+    for (u32 i = 0; i < length && written + 7 < capacity; i++)
+    {
+        char character = string[i];
+        switch (character)
+        {
+            case '"':
+            case '\\':
+                p_text[written++] = '\\';
+                p_text[written++] = character;
+                break;
+            case '\n':
+                p_text[written++] = '\\';
+                p_text[written++] = 'n';
+                break;
+            case '\t':
+                p_text[written++] = '\\';
+                p_text[written++] = 't';
+                break;
+            default:
+                // control characters, color codes included, need unicode escape
+                if ((u8)character < 0x20)
+                {
+                    written += snprintf(p_text + written, capacity - written, "\\u%04x", (u8)character);
+                }
+                else
+                {
+                    p_text[written++] = character;
+                }
+                break;
+        }
+    }
+
+    p_text[written] = '\0';
+    return written;
+}
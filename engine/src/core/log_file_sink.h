@@ -0,0 +1,33 @@
+#pragma once
+
+#include "defines.h"
+#include "core/logger.h"
+#include "platform/file_map.h"
+
+#define LOG_FILE_MAX_PATH_LENGTH 256
+
+typedef enum LogFileFormat {
+    LOG_FILE_FORMAT_TEXT,               // [seconds.micros] [LEVEL] Channel: message
+    LOG_FILE_FORMAT_JSON                // one json object per line
+} LogFileFormat;
+
+// writes log lines straight into memory mapped, preallocated file, so lines cost no syscall
+// when file is full it is rotated: path -> path.1 -> ... -> path.n, oldest is overwritten
+// file is cut to written size when it is closed, if process crashes file ends with zero bytes instead,
+// so readers must stop at first zero byte, next sink created with same path trims it and rotates it to path.1
+typedef struct LogFileSink {
+    char path[LOG_FILE_MAX_PATH_LENGTH];
+    u64 fileSize;
+    u32 fileCount;
+    LogFileFormat format;
+    u64 wallClockOffset;                // added to monotonic timestamps to get unix time
+    u64 used;
+    FileMap map;
+} LogFileSink;
+
+EXPORT b8 CreateLogFileSink(LogFileSink* p_sink, const char* path, const u64 fileSize, const u32 fileCount, const LogFileFormat format);
+
+EXPORT void DestroyLogFileSink(LogFileSink* p_sink);
+
+// sink interface to pass to AddLogSink
+EXPORT LogSink GetLogFileSink(LogFileSink* p_sink, const u8 flags);
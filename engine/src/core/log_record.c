@@ -0,0 +1,391 @@
+#include "core/log_record.h"
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_LOG_SPEC_LENGTH 32
+
+typedef enum LogArgKind {
+    LOG_ARG_KIND_NONE,                  // %% and %n, nothing is stored
+    LOG_ARG_KIND_I32,                   // int sized integers and chars, after promotion
+    LOG_ARG_KIND_I64,                   // l, ll, j, z, t sized integers
+    LOG_ARG_KIND_F64,                   // floating point, after promotion
+    LOG_ARG_KIND_STRING,                // copied inline
+    LOG_ARG_KIND_POINTER
+} LogArgKind;
+
+typedef struct LogSpec {
+    u32 length;                         // characters from '%' to conversion, inclusive
+    u32 starCount;                      // width and precision taken from arguments
+    b8 isLongDouble;
+    LogArgKind kind;
+} LogSpec;
+
+// parses conversion starting at '%'
+static LogSpec ParseLogSpec(const char* spec)
+{
+    LogSpec result = { .kind = LOG_ARG_KIND_NONE };
+    u32 i = 1;
+    b8 isWide = false;
+
+    // flags
+    while (spec[i] == '-' || spec[i] == '+' || spec[i] == ' ' || spec[i] == '#' || spec[i] == '0' || spec[i] == '\'')
+    {
+        i++;
+    }
+
+    // width and precision
+    for (u32 part = 0; part < 2; part++)
+    {
+        if (part == 1)
+        {
+            if (spec[i] != '.')
+            {
+                break;
+            }
+            i++;
+        }
+        if (spec[i] == '*')
+        {
+            result.starCount++;
+            i++;
+        }
+        while (spec[i] >= '0' && spec[i] <= '9')
+        {
+            i++;
+        }
+    }
+
+    // length modifiers
+    while (true)
+    {
+        switch (spec[i])
+        {
+            case 'h':
+                i++;
+                continue;
+            case 'L':
+                result.isLongDouble = true;
+                i++;
+                continue;
+            case 'l': case 'j': case 'z': case 't': case 'q':
+                isWide = true;
+                i++;
+                continue;
+        }
+        break;
+    }
+
+    // conversion
+    switch (spec[i])
+    {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+            result.kind = isWide ? LOG_ARG_KIND_I64 : LOG_ARG_KIND_I32;
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            result.kind = LOG_ARG_KIND_F64;
+            break;
+        case 's':
+            result.kind = LOG_ARG_KIND_STRING;
+            break;
+        case 'p': case 'n':
+            result.kind = LOG_ARG_KIND_POINTER;
+            break;
+        case '\0':
+            result.length = i;
+            return result;
+    }
+
+    result.length = i + 1;
+    return result;
+}
+
+u32 EncodeLogRecord(u8* p_record, const u32 capacity, const u8 verbosity, const u64 timestamp,
+        const char* channel, const char* format, va_list list)
+{
+    // make sure header fits
+    if (capacity < sizeof(LogRecordHeader))
+    {
+        return 0;
+    }
+
+    // argument bytes start after header
+    u32 size = sizeof(LogRecordHeader);
+
+    // jump from spec to spec, store every argument they consume
+    for (const char* p = strchr(format, '%'); p; p = strchr(p + 1, '%'))
+    {
+        LogSpec spec = ParseLogSpec(p);
+        p += spec.length - 1;
+
+        // width and precision arguments come first
+        for (u32 i = 0; i < spec.starCount; i++)
+        {
+            i32 value = va_arg(list, i32);
+            if (size + sizeof(value) <= capacity)
+            {
+                memcpy(p_record + size, &value, sizeof(value));
+                size += sizeof(value);
+            }
+        }
+
+        // store argument raw, every argument is consumed even if it does not fit
+        switch (spec.kind)
+        {
+            case LOG_ARG_KIND_NONE:
+                break;
+            case LOG_ARG_KIND_I32:
+            {
+                i32 value = va_arg(list, i32);
+                if (size + sizeof(value) <= capacity)
+                {
+                    memcpy(p_record + size, &value, sizeof(value));
+                    size += sizeof(value);
+                }
+                break;
+            }
+            case LOG_ARG_KIND_I64:
+            {
+                i64 value = va_arg(list, i64);
+                if (size + sizeof(value) <= capacity)
+                {
+                    memcpy(p_record + size, &value, sizeof(value));
+                    size += sizeof(value);
+                }
+                break;
+            }
+            case LOG_ARG_KIND_F64:
+            {
+                f64 value = spec.isLongDouble ? (f64)va_arg(list, long double) : va_arg(list, f64);
+                if (size + sizeof(value) <= capacity)
+                {
+                    memcpy(p_record + size, &value, sizeof(value));
+                    size += sizeof(value);
+                }
+                break;
+            }
+            case LOG_ARG_KIND_STRING:
+            {
+                // copy as much of string as fits
+                const char* value = va_arg(list, const char*);
+                if (!value)
+                {
+                    value = "(null)";
+                }
+                if (size + sizeof(u16) <= capacity)
+                {
+                    u32 length = strlen(value);
+                    u32 space = capacity - size - sizeof(u16);
+                    u16 stored = length < space ? length : space;
+                    memcpy(p_record + size, &stored, sizeof(stored));
+                    memcpy(p_record + size + sizeof(stored), value, stored);
+                    size += sizeof(stored) + stored;
+                }
+                break;
+            }
+            case LOG_ARG_KIND_POINTER:
+            {
+                void* value = va_arg(list, void*);
+                if (size + sizeof(value) <= capacity)
+                {
+                    memcpy(p_record + size, &value, sizeof(value));
+                    size += sizeof(value);
+                }
+                break;
+            }
+        }
+    }
+
+    // write header last, size is known now
+    LogRecordHeader header = {
+        .size = size,
+        .verbosity = verbosity,
+        .timestamp = timestamp,
+        .channel = channel,
+        .format = format
+    };
+    memcpy(p_record, &header, sizeof(header));
+    return size;
+}
+
+u32 EncodeLogText(u8* p_record, const u32 capacity, const u8 verbosity, const u64 timestamp,
+        const char* channel, const char* format, va_list list)
+{
+    // make sure header fits
+    if (capacity < sizeof(LogRecordHeader))
+    {
+        return 0;
+    }
+
+    // format message after header, terminator is not part of record
+    u32 size = sizeof(LogRecordHeader);
+    i32 length = vsnprintf((char*)p_record + size, capacity - size, format, list);
+    if (length > 0 && capacity > size)
+    {
+        size += (u32)length < capacity - size ? (u32)length : capacity - size - 1;
+    }
+
+    // write header, no format marks record as text
+    LogRecordHeader header = {
+        .size = size,
+        .verbosity = verbosity,
+        .timestamp = timestamp,
+        .channel = channel,
+        .format = null
+    };
+    memcpy(p_record, &header, sizeof(header));
+    return size;
+}
+
+u32 DecodeLogRecord(const u8* p_record, char* p_text, const u32 capacity)
+{
+    // read header
+    LogRecordHeader header;
+    memcpy(&header, p_record, sizeof(header));
+    const u8* p_argument = p_record + sizeof(header);
+    const u8* p_end = p_record + header.size;
+
+    // text written so far, kept below capacity so terminator always fits
+    u32 length = 0;
+    if (capacity == 0)
+    {
+        return 0;
+    }
+    p_text[0] = '\0';
+
+    // text records only need copying
+    if (!header.format)
+    {
+        length = p_end - p_argument < capacity - 1 ? p_end - p_argument : capacity - 1;
+        memcpy(p_text, p_argument, length);
+        p_text[length] = '\0';
+        return length;
+    }
+
+    for (const char* p = header.format; *p && length + 1 < capacity; p++)
+    {
+        // copy plain characters
+        if (*p != '%')
+        {
+            p_text[length++] = *p;
+            p_text[length] = '\0';
+            continue;
+        }
+
+        // copy spec, long double values were stored as double
+        LogSpec spec = ParseLogSpec(p);
+        char format[MAX_LOG_SPEC_LENGTH];
+        u32 formatLength = 0;
+        for (u32 i = 0; i < spec.length && formatLength + 1 < MAX_LOG_SPEC_LENGTH; i++)
+        {
+            if (p[i] != 'L')
+            {
+                format[formatLength++] = p[i];
+            }
+        }
+        format[formatLength] = '\0';
+        p += spec.length - 1;
+
+        // read width and precision
+        i32 stars[2] = {};
+        for (u32 i = 0; i < spec.starCount && p_argument + sizeof(i32) <= p_end; i++)
+        {
+            memcpy(&stars[i], p_argument, sizeof(i32));
+            p_argument += sizeof(i32);
+        }
+
+        // stop at truncated argument
+        u32 space = capacity - length;
+        i32 written = 0;
+        #define FORMAT_LOG_ARG(value)                                                                   \
+            written = spec.starCount == 0 ? snprintf(p_text + length, space, format, value) :          \
+                      spec.starCount == 1 ? snprintf(p_text + length, space, format, stars[0], value) : \
+                      snprintf(p_text + length, space, format, stars[0], stars[1], value)
+        switch (spec.kind)
+        {
+            case LOG_ARG_KIND_NONE:
+                if (format[formatLength - 1] == '%')
+                {
+                    written = snprintf(p_text + length, space, "%%");
+                }
+                break;
+            case LOG_ARG_KIND_I32:
+            {
+                i32 value = 0;
+                if (p_argument + sizeof(value) > p_end)
+                {
+                    return length;
+                }
+                memcpy(&value, p_argument, sizeof(value));
+                p_argument += sizeof(value);
+                FORMAT_LOG_ARG(value);
+                break;
+            }
+            case LOG_ARG_KIND_I64:
+            {
+                i64 value = 0;
+                if (p_argument + sizeof(value) > p_end)
+                {
+                    return length;
+                }
+                memcpy(&value, p_argument, sizeof(value));
+                p_argument += sizeof(value);
+                FORMAT_LOG_ARG(value);
+                break;
+            }
+            case LOG_ARG_KIND_F64:
+            {
+                f64 value = 0;
+                if (p_argument + sizeof(value) > p_end)
+                {
+                    return length;
+                }
+                memcpy(&value, p_argument, sizeof(value));
+                p_argument += sizeof(value);
+                FORMAT_LOG_ARG(value);
+                break;
+            }
+            case LOG_ARG_KIND_STRING:
+            {
+                // string is not terminated in record, print it with precision of its length
+                u16 stored = 0;
+                if (p_argument + sizeof(stored) > p_end)
+                {
+                    return length;
+                }
+                memcpy(&stored, p_argument, sizeof(stored));
+                p_argument += sizeof(stored);
+                char value[LOG_RECORD_MAX_STRING_LENGTH];
+                u32 copied = stored < sizeof(value) - 1 ? stored : sizeof(value) - 1;
+                memcpy(value, p_argument, copied);
+                value[copied] = '\0';
+                p_argument += stored;
+                FORMAT_LOG_ARG(value);
+                break;
+            }
+            case LOG_ARG_KIND_POINTER:
+            {
+                void* value = null;
+                if (p_argument + sizeof(value) > p_end)
+                {
+                    return length;
+                }
+                memcpy(&value, p_argument, sizeof(value));
+                p_argument += sizeof(value);
+                if (format[formatLength - 1] == 'p')
+                {
+                    FORMAT_LOG_ARG(value);
+                }
+                break;
+            }
+        }
+        #undef FORMAT_LOG_ARG
+
+        // snprintf returns length it wanted, clamp to what fit
+        if (written > 0)
+        {
+            length += (u32)written < space ? (u32)written : space - 1;
+        }
+    }
+
+    return length;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "defines.h"
+#include <stdarg.h>
+
+#define LOG_RECORD_MAX_STRING_LENGTH 1024
+
+// binary log record, formatting is deferred to whoever decodes it
+// layout: [header][argument bytes], numbers are stored raw, strings inline as [u16 length][chars]
+// text records have no format and carry formatted message instead of arguments
+// channel and format are pointers to static strings, so records only decode inside process that wrote them
+typedef struct LogRecordHeader {
+    u32 size;                           // whole record including header
+    u8 verbosity;
+    u8 reserved[3];
+    u64 timestamp;
+    const char* channel;
+    const char* format;
+} LogRecordHeader;
+
+// returns record size, 0 if header does not fit, too long arguments are truncated
+u32 EncodeLogRecord(u8* p_record, const u32 capacity, const u8 verbosity, const u64 timestamp,
+        const char* channel, const char* format, va_list list);
+
+// formats message on calling thread, for when deferring is not wanted
+u32 EncodeLogText(u8* p_record, const u32 capacity, const u8 verbosity, const u64 timestamp,
+        const char* channel, const char* format, va_list list);
+
+// formats body of record into text, returns text length without terminator
+u32 DecodeLogRecord(const u8* p_record, char* p_text, const u32 capacity);
@@ -1,42 +1,139 @@
 #include "core/logger.h"
+#include "core/memory.h"
+#include "core/log_record.h"
+#include "core/profiler.h"
+#include "platform/clock.h"
+#include "platform/thread.h"
 #include "defines.h"
+#include <stdatomic.h>
 #include <stdio.h>
+#include <string.h>
 
 #define CHANNEL "Logger"
 
+// single producer single consumer byte ring, every thread that logs owns one
+// producer copies whole records in, writer thread hands everything between head and tail to sinks
+typedef struct LogRing {
+    _Alignas(CACHE_LINE_SIZE) _Atomic u32 head;
+    _Alignas(CACHE_LINE_SIZE) _Atomic u32 tail;
+    u32 cachedHead;                     // last head producer saw, saves reading writer's line on every push
+    char buffer[LOG_RING_SIZE];
+} LogRing;
+
 static u8 verbosityFlags = 0;
 
+u8 logEnabledFlags = 0;
+
+// channels with own verbosity flags
+typedef struct LogChannel {
+    char name[LOG_MAX_CHANNEL_LENGTH];
+    u8 flags;
+} LogChannel;
+
+static LogChannel channels[LOG_MAX_CHANNEL_COUNT];
+static u32 channelCount = 0;
+
 static const char* verbosityHeaders[] =
 { "ERROR", "WARNING", "SUCCESS", "INFO" };
 
 static const char* verbosityColors[] =
 { "\e[0;31m", "\e[0;33m", "\e[0;32m", "\e[0;34m" };
 
+// sinks, sync mode threads and writer thread both write to them, so they are used under spin lock
+static LogSink sinks[LOG_MAX_SINK_COUNT];
+static u32 sinkCount = 0;
+static atomic_flag sinkLock = ATOMIC_FLAG_INIT;
+
+// set while thread is inside sink, logs made by sink go to stderr instead of locking again
+static _Thread_local b8 isInsideSink = false;
+
+// async mode state
+static _Atomic b8 isAsync = false;
+static b8 isBinary = false;
+static _Atomic b8 isWriterRunning = false;
+static Thread writerThread;
+static LogRing rings[LOG_MAX_THREAD_COUNT];
+static _Atomic u32 ringCount = 0;
+static _Thread_local LogRing* p_threadRing = null;
+
+// ring of exited thread is released, writer frees it once it is drained so next thread can claim it
+typedef enum LogRingState {
+    LOG_RING_STATE_FREE,
+    LOG_RING_STATE_OWNED,
+    LOG_RING_STATE_RELEASED
+} LogRingState;
+static _Atomic u8 ringStates[LOG_MAX_THREAD_COUNT];
+static ThreadExitHook ringExitHook;
+static b8 hasRingExitHook = false;
+
+// flush tickets, writer completes every ticket requested before its pass started
+static _Atomic u64 requestedFlush = 0;
+static _Atomic u64 completedFlush = 0;
+
+static void* RunLogWriter(void* p_data);
+static u32 DrainLogRings(void);
+static LogRing* ClaimLogRing(void);
+static void ReleaseLogRing(void* p_data);
+static void WriteLogRecords(LogRing* p_ring, const u32 head, const u32 tail);
+static void WriteLogRecord(const u8* p_record);
+static void FlushLogSinks(void);
+static void CopyFromLogRing(const LogRing* p_ring, const u32 position, void* p_destination, const u32 length);
+static void PushLogRing(LogRing* p_ring, const u8* p_record, const u32 length);
+static b8 IsLogEnabled(const LogVerbosity verbosity, const char* channel);
+static void UpdateLogEnabledFlags(void);
+static void WriteConsoleLogSink(void* p_data, const LogEntry* p_entry);
+static void FlushConsoleLogSink(void* p_data);
+
 b8 StartupLogSystem(const u8 flags)
 {
+    PROFILE_FUNCTION();
+
     // check if provided flags are in correct bound
-    if (
-            (flags & (
-                      LOG_VERBOSITY_FLAG_ERROR |
-                      LOG_VERBOSITY_FLAG_WARNING |
-                      LOG_VERBOSITY_FLAG_SUCCESS |
-                      LOG_VERBOSITY_FLAG_INFO
-                     )) == 0)
+    if ((flags & LOG_VERBOSITY_FLAG_ALL) == 0)
     {
         return false;
     }
 
     // asign provided flags to verbosity flags
-    verbosityFlags = flags;
+    verbosityFlags = flags & LOG_VERBOSITY_FLAG_ALL;
+    UpdateLogEnabledFlags();
+
+    // console is default sink
+    LogSink console = GetConsoleLogSink();
+    AddLogSink(&console);
+
+    // start writer thread, stay synchronous if it can not start
+    if (flags & (LOG_FLAG_ASYNC | LOG_FLAG_BINARY))
+    {
+        // rings are given back when threads exit, hook outlives restarts of system
+        if (!hasRingExitHook)
+        {
+            hasRingExitHook = CreateThreadExitHook(&ringExitHook, ReleaseLogRing);
+        }
+
+        isBinary = (flags & LOG_FLAG_BINARY) != 0;
+        atomic_store(&isWriterRunning, true);
+        if (CreateThread(&writerThread, RunLogWriter, null))
+        {
+            atomic_store(&isAsync, true);
+        }
+        else
+        {
+            atomic_store(&isWriterRunning, false);
+            isBinary = false;
+            LogWarning(CHANNEL, "Writer Thread Not Created, Logging Synchronously");
+        }
+    }
 
     // return success as default
-    LogSuccess(CHANNEL, SYSTEM_INITIALIZED_MESSAGE);
+    LogSuccess(CHANNEL, "%s {Async: %s, Binary: %s}", SYSTEM_INITIALIZED_MESSAGE,
+            atomic_load(&isAsync) ? "Yes" : "No", isBinary ? "Yes" : "No");
     return true;
 }
 
 u8 GetLogVerbosityFlag(const LogVerbosity verbosity)
 {
-    switch (verbosity) 
+    switch (verbosity)
     {
         case LOG_VERBOSITY_ERROR:
             return LOG_VERBOSITY_FLAG_ERROR;
@@ -57,29 +154,230 @@ u8 GetLogVerbosityFlag(const LogVerbosity verbosity)
     }
 }
 
+const char* GetLogVerbosityName(const LogVerbosity verbosity)
+{
+    return verbosityHeaders[verbosity];
+}
+
 void ShutdownLogSystem(void)
 {
-    // zero out verbosity flags
     LogSuccess(CHANNEL, SYSTEM_TERMINATED_MESSAGE);
+
+    // stop writer thread, it writes everything left before returning
+    if (atomic_load(&isAsync))
+    {
+        atomic_store(&isWriterRunning, false);
+        JoinThread(&writerThread);
+        atomic_store(&isAsync, false);
+        isBinary = false;
+    }
+
+    // flush and forget sinks
+    FlushLogSinks();
+    sinkCount = 0;
+
+    // zero out verbosity flags
     verbosityFlags = 0;
+    channelCount = 0;
+    UpdateLogEnabledFlags();
+}
+
+void SetLogChannelFlags(const char* channel, const u8 flags)
+{
+    // make sure name fits
+    if (strlen(channel) >= LOG_MAX_CHANNEL_LENGTH)
+    {
+        LogWarning(CHANNEL, "Too Long Channel Name \"%s\"", channel);
+        return;
+    }
+
+    // update channel if it already has flags
+    for (u32 i = 0; i < channelCount; i++)
+    {
+        if (strcmp(channels[i].name, channel) == 0)
+        {
+            channels[i].flags = flags & LOG_VERBOSITY_FLAG_ALL;
+            UpdateLogEnabledFlags();
+            return;
+        }
+    }
+
+    // make sure there is space for new channel
+    if (channelCount == LOG_MAX_CHANNEL_COUNT)
+    {
+        LogWarning(CHANNEL, "Too Many Channels, \"%s\" Flags Not Set", channel);
+        return;
+    }
+
+    // add channel
+    strcpy(channels[channelCount].name, channel);
+    channels[channelCount].flags = flags & LOG_VERBOSITY_FLAG_ALL;
+    channelCount++;
+    UpdateLogEnabledFlags();
+}
+
+void ClearLogChannelFlags(const char* channel)
+{
+    // loop thro channels
+    for (u32 i = 0; i < channelCount; i++)
+    {
+        // if names much, move last channel in its place
+        if (strcmp(channels[i].name, channel) == 0)
+        {
+            channels[i] = channels[--channelCount];
+            UpdateLogEnabledFlags();
+            return;
+        }
+    }
+}
+
+b8 AddLogSink(const LogSink* p_sink)
+{
+    // make sure sink can write
+    if (!p_sink || !p_sink->Write)
+    {
+        LogWarning(CHANNEL, "Invalid Sink Provided");
+        return false;
+    }
+
+    // take sink lock
+    while (atomic_flag_test_and_set_explicit(&sinkLock, memory_order_acquire));
+
+    // update sink if it is already added, otherwise append it
+    b8 isAdded = false;
+    for (u32 i = 0; i < sinkCount; i++)
+    {
+        if (sinks[i].Write == p_sink->Write && sinks[i].p_data == p_sink->p_data)
+        {
+            sinks[i] = *p_sink;
+            isAdded = true;
+            break;
+        }
+    }
+    if (!isAdded && sinkCount < LOG_MAX_SINK_COUNT)
+    {
+        sinks[sinkCount++] = *p_sink;
+        isAdded = true;
+    }
+
+    // release sink lock
+    atomic_flag_clear_explicit(&sinkLock, memory_order_release);
+
+    if (!isAdded)
+    {
+        LogWarning(CHANNEL, "Too Many Sinks, Sink Not Added");
+    }
+    return isAdded;
+}
+
+void RemoveLogSink(const LogSink* p_sink)
+{
+    // let writer hand sink everything logged so far
+    FlushLogs();
+
+    // take sink lock
+    while (atomic_flag_test_and_set_explicit(&sinkLock, memory_order_acquire));
+
+    // loop thro sinks
+    for (u32 i = 0; i < sinkCount; i++)
+    {
+        // if sinks much, flush it and move last sink in its place
+        if (sinks[i].Write == p_sink->Write && sinks[i].p_data == p_sink->p_data)
+        {
+            if (sinks[i].Flush)
+            {
+                sinks[i].Flush(sinks[i].p_data);
+            }
+            sinks[i] = sinks[--sinkCount];
+            break;
+        }
+    }
+
+    // release sink lock
+    atomic_flag_clear_explicit(&sinkLock, memory_order_release);
+}
+
+LogSink GetConsoleLogSink(void)
+{
+    return (LogSink){
+        .Write = WriteConsoleLogSink,
+        .Flush = FlushConsoleLogSink,
+        .p_data = null,
+        .flags = LOG_VERBOSITY_FLAG_ALL
+    };
+}
+
+void FlushLogs(void)
+{
+    // sink can not wait for itself, writer flushes after every pass anyway
+    if (isInsideSink)
+    {
+        return;
+    }
+
+    // sync mode only has buffers of sinks
+    if (!atomic_load(&isAsync))
+    {
+        FlushLogSinks();
+        return;
+    }
+
+    // take ticket and wait until writer completes it
+    u64 ticket = atomic_fetch_add(&requestedFlush, 1) + 1;
+    while (atomic_load(&completedFlush) < ticket)
+    {
+        SleepThread(50);
+    }
 }
 
 void LogV(const LogVerbosity verbosity, const char* channel, const char* format, va_list list)
 {
-    // make sure current verbosity is enabled
-    if (!(verbosityFlags & GetLogVerbosityFlag(verbosity)))
+    // make sure current verbosity is enabled for channel
+    if (!IsLogEnabled(verbosity, channel))
     {
         return;
     }
 
-    // set color and log header and channel
-    printf("%s[%s] %s: ", verbosityColors[verbosity], verbosityHeaders[verbosity], channel);
+    // sink logged something, sinks are already busy with this thread
+    if (isInsideSink)
+    {
+        fprintf(stderr, "[%s] %s: ", verbosityHeaders[verbosity], channel);
+        vfprintf(stderr, format, list);
+        fputc('\n', stderr);
+        return;
+    }
 
-    // log body of log
-    vprintf(format, list);
+    // take ring of this thread, first log of thread claims one, no ring left means thread logs synchronously
+    b8 isThreadAsync = atomic_load(&isAsync);
+    if (isThreadAsync && !p_threadRing)
+    {
+        p_threadRing = ClaimLogRing();
+        isThreadAsync = p_threadRing != null;
+    }
+
+    // binary mode only copies arguments, otherwise message is formatted here
+    _Alignas(8) u8 record[LOG_MAX_MESSAGE_LENGTH];
+    u32 size = isThreadAsync && isBinary ?
+        EncodeLogRecord(record, sizeof(record), verbosity, GetClockNanoseconds(), channel, format, list) :
+        EncodeLogText(record, sizeof(record), verbosity, GetClockNanoseconds(), channel, format, list);
+
+    // hand record to writer, or write it now
+    if (isThreadAsync)
+    {
+        PushLogRing(p_threadRing, record, size);
+    }
+    else
+    {
+        while (atomic_flag_test_and_set_explicit(&sinkLock, memory_order_acquire));
+        WriteLogRecord(record);
+        atomic_flag_clear_explicit(&sinkLock, memory_order_release);
+    }
 
-    // reset color and start new line
-    puts("\e[0;37m");
+    // errors often come right before crash, make sure they are out
+    if (verbosity == LOG_VERBOSITY_ERROR)
+    {
+        FlushLogs();
+    }
 }
 
 void Log(const LogVerbosity verbosity, const char* channel, const char* format, ...)
@@ -94,3 +392,246 @@ void Log(const LogVerbosity verbosity, const char* channel, const char* format,
     // terminate list
     va_end(list);
 }
+
+static void* RunLogWriter(void* p_data)
+{
+    (void)p_data;
+
+    while (true)
+    {
+        // remember flush requests made before this pass
+        u64 requested = atomic_load(&requestedFlush);
+        b8 isRunning = atomic_load(&isWriterRunning);
+
+        // hand everything queued so far to sinks in one batch
+        u32 written = DrainLogRings();
+        if (written > 0 || requested != atomic_load(&completedFlush))
+        {
+            FlushLogSinks();
+        }
+        atomic_store(&completedFlush, requested);
+
+        // exit after last pass, every ring was drained after running flag cleared
+        if (!isRunning)
+        {
+            break;
+        }
+
+        // let lines pile up between passes, so writes happen in batches and rings are not fought over
+        if (written < LOG_RING_SIZE / 4 && atomic_load(&requestedFlush) == requested)
+        {
+            SleepThread(1000);
+        }
+    }
+
+    return null;
+}
+
+static u32 DrainLogRings(void)
+{
+    u32 written = 0;
+
+    // loop thro rings claimed by threads
+    u32 count = atomic_load(&ringCount);
+    for (u32 i = 0; i < count && i < LOG_MAX_THREAD_COUNT; i++)
+    {
+        LogRing* p_ring = &rings[i];
+        u32 head = atomic_load_explicit(&p_ring->head, memory_order_relaxed);
+        u32 tail = atomic_load_explicit(&p_ring->tail, memory_order_acquire);
+        if (head == tail)
+        {
+            continue;
+        }
+
+        // write records under sink lock
+        while (atomic_flag_test_and_set_explicit(&sinkLock, memory_order_acquire));
+        WriteLogRecords(p_ring, head, tail);
+        atomic_flag_clear_explicit(&sinkLock, memory_order_release);
+
+        // give space back to producer
+        atomic_store_explicit(&p_ring->head, tail, memory_order_release);
+        written += tail - head;
+    }
+
+    // free rings of exited threads once nothing is left in them, thread pushed everything before releasing
+    for (u32 i = 0; i < count && i < LOG_MAX_THREAD_COUNT; i++)
+    {
+        if (atomic_load_explicit(&ringStates[i], memory_order_acquire) == LOG_RING_STATE_RELEASED &&
+                atomic_load_explicit(&rings[i].head, memory_order_relaxed) == atomic_load_explicit(&rings[i].tail, memory_order_relaxed))
+        {
+            atomic_store_explicit(&ringStates[i], LOG_RING_STATE_FREE, memory_order_release);
+        }
+    }
+
+    return written;
+}
+
+static LogRing* ClaimLogRing(void)
+{
+    // take first free ring
+    for (u32 i = 0; i < LOG_MAX_THREAD_COUNT; i++)
+    {
+        u8 expected = LOG_RING_STATE_FREE;
+        if (atomic_compare_exchange_strong_explicit(&ringStates[i], &expected, LOG_RING_STATE_OWNED, 
+                    memory_order_acquire, memory_order_relaxed))
+        {
+            // make sure writer drains it, before first record is pushed
+            u32 count = atomic_load(&ringCount);
+            while (count < i + 1 && !atomic_compare_exchange_weak(&ringCount, &count, i + 1));
+
+            // give it back when thread exits
+            if (hasRingExitHook)
+            {
+                ArmThreadExitHook(&ringExitHook, &rings[i]);
+            }
+            return &rings[i];
+        }
+    }
+
+    return null;
+}
+
+static void ReleaseLogRing(void* p_data)
+{
+    // thread is exiting, it pushes nothing more to its ring
+    LogRing* p_ring = p_data;
+    p_threadRing = null;
+    atomic_store_explicit(&ringStates[p_ring - rings], LOG_RING_STATE_RELEASED, memory_order_release);
+}
+
+static void WriteLogRecords(LogRing* p_ring, const u32 head, const u32 tail)
+{
+    // loop thro records, every one starts with its size
+    for (u32 position = head; position != tail;)
+    {
+        // copy record out of ring, it may wrap
+        _Alignas(8) u8 record[LOG_MAX_MESSAGE_LENGTH];
+        u32 size = 0;
+        CopyFromLogRing(p_ring, position, &size, sizeof(size));
+        CopyFromLogRing(p_ring, position, record, size);
+        position += size;
+
+        WriteLogRecord(record);
+    }
+}
+
+static void WriteLogRecord(const u8* p_record)
+{
+    // decode message, binary records are formatted here
+    LogRecordHeader header;
+    memcpy(&header, p_record, sizeof(header));
+    char message[LOG_MAX_MESSAGE_LENGTH + LOG_RECORD_MAX_STRING_LENGTH];
+    LogEntry entry = {
+        .verbosity = header.verbosity,
+        .timestamp = header.timestamp,
+        .channel = header.channel,
+        .message = message,
+        .length = DecodeLogRecord(p_record, message, sizeof(message))
+    };
+
+    // hand entry to every sink that accepts its verbosity, caller holds sink lock
+    isInsideSink = true;
+    u8 flag = GetLogVerbosityFlag(entry.verbosity);
+    for (u32 i = 0; i < sinkCount; i++)
+    {
+        if (sinks[i].flags & flag)
+        {
+            sinks[i].Write(sinks[i].p_data, &entry);
+        }
+    }
+    isInsideSink = false;
+}
+
+static void FlushLogSinks(void)
+{
+    // take sink lock
+    while (atomic_flag_test_and_set_explicit(&sinkLock, memory_order_acquire));
+
+    // flush sinks that buffer
+    isInsideSink = true;
+    for (u32 i = 0; i < sinkCount; i++)
+    {
+        if (sinks[i].Flush)
+        {
+            sinks[i].Flush(sinks[i].p_data);
+        }
+    }
+    isInsideSink = false;
+
+    // release sink lock
+    atomic_flag_clear_explicit(&sinkLock, memory_order_release);
+}
+
+static void CopyFromLogRing(const LogRing* p_ring, const u32 position, void* p_destination, const u32 length)
+{
+    // copy up to end of buffer, then wrapped part
+    u32 offset = position & (LOG_RING_SIZE - 1);
+    u32 first = length < LOG_RING_SIZE - offset ? length : LOG_RING_SIZE - offset;
+    memcpy(p_destination, p_ring->buffer + offset, first);
+    memcpy((u8*)p_destination + first, p_ring->buffer, length - first);
+}
+
+static void PushLogRing(LogRing* p_ring, const u8* p_record, const u32 length)
+{
+    // wait for writer to make space, records are never dropped
+    u32 tail = atomic_load_explicit(&p_ring->tail, memory_order_relaxed);
+    while (LOG_RING_SIZE - (tail - p_ring->cachedHead) < length)
+    {
+        p_ring->cachedHead = atomic_load_explicit(&p_ring->head, memory_order_acquire);
+        if (LOG_RING_SIZE - (tail - p_ring->cachedHead) < length)
+        {
+            SleepThread(50);
+        }
+    }
+
+    // copy record, wrapping at end of buffer
+    u32 offset = tail & (LOG_RING_SIZE - 1);
+    u32 first = length < LOG_RING_SIZE - offset ? length : LOG_RING_SIZE - offset;
+    memcpy(p_ring->buffer + offset, p_record, first);
+    memcpy(p_ring->buffer, p_record + first, length - first);
+
+    // publish record to writer
+    atomic_store_explicit(&p_ring->tail, tail + length, memory_order_release);
+}
+
+static b8 IsLogEnabled(const LogVerbosity verbosity, const char* channel)
+{
+    // channel flags win over global ones
+    for (u32 i = 0; i < channelCount; i++)
+    {
+        if (strcmp(channels[i].name, channel) == 0)
+        {
+            return (channels[i].flags & GetLogVerbosityFlag(verbosity)) != 0;
+        }
+    }
+
+    return (verbosityFlags & GetLogVerbosityFlag(verbosity)) != 0;
+}
+
+static void UpdateLogEnabledFlags(void)
+{
+    // merge global and channel flags
+    u8 flags = verbosityFlags;
+    for (u32 i = 0; i < channelCount; i++)
+    {
+        flags |= channels[i].flags;
+    }
+    logEnabledFlags = flags;
+}
+
+static void WriteConsoleLogSink(void* p_data, const LogEntry* p_entry)
+{
+    (void)p_data;
+
+    // set color and log header and channel, then body, then reset color and start new line
+    fprintf(stdout, "%s[%s] %s: ", verbosityColors[p_entry->verbosity], verbosityHeaders[p_entry->verbosity], p_entry->channel);
+    fwrite(p_entry->message, 1, p_entry->length, stdout);
+    fputs("\e[0;37m\n", stdout);
+}
+
+static void FlushConsoleLogSink(void* p_data)
+{
+    (void)p_data;
+
+    fflush(stdout);
+}
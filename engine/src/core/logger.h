@@ -7,6 +7,29 @@
 #define LOG_VERBOSITY_FLAG_WARNING 0x02
 #define LOG_VERBOSITY_FLAG_SUCCESS 0x04
 #define LOG_VERBOSITY_FLAG_INFO 0x08
+#define LOG_VERBOSITY_FLAG_ALL 0x0F
+
+// format on calling thread, write on background thread
+#define LOG_FLAG_ASYNC 0x10
+
+// store format pointer and raw arguments, format on writer thread, implies async
+#define LOG_FLAG_BINARY 0x20
+
+#define LOG_MAX_MESSAGE_LENGTH 1024
+#define LOG_MAX_THREAD_COUNT 8
+#define LOG_RING_SIZE (64 * 1024)
+#define LOG_MAX_CHANNEL_COUNT 32
+#define LOG_MAX_CHANNEL_LENGTH 32
+#define LOG_MAX_SINK_COUNT 8
+
+// most verbose level compiled in, calls above it compile out, override with -DLOG_COMPILED_VERBOSITY=n
+#if !defined(LOG_COMPILED_VERBOSITY)
+    #if defined(DEBUG)
+        #define LOG_COMPILED_VERBOSITY 3
+    #else
+        #define LOG_COMPILED_VERBOSITY 2
+    #endif
+#endif
 
 typedef enum LogVerbosity {
     LOG_VERBOSITY_ERROR,
@@ -15,20 +38,69 @@ typedef enum LogVerbosity {
     LOG_VERBOSITY_INFO
 } LogVerbosity;
 
+// one log line handed to sinks, message is not colored or terminated by new line
+typedef struct LogEntry {
+    LogVerbosity verbosity;
+    u64 timestamp;                      // monotonic nanoseconds
+    const char* channel;
+    const char* message;
+    u32 length;
+} LogEntry;
+
+// output of logger, writer thread calls sinks one at a time, so they need no locking
+typedef struct LogSink {
+    void (*Write)(void* p_data, const LogEntry* p_entry);
+    void (*Flush)(void* p_data);
+
+    void* p_data;
+    u8 flags;                           // verbosity flags sink accepts
+} LogSink;
+
+// every verbosity flag enabled globally or by any channel, lets macros skip disabled calls inline
+EXPORT extern u8 logEnabledFlags;
+
 EXPORT b8 StartupLogSystem(const u8 flags);
 
 EXPORT void ShutdownLogSystem(void);
 
+// blocks until every message logged before call is written
+EXPORT void FlushLogs(void);
+
 u8 GetLogVerbosityFlag(const LogVerbosity verbosity);
 
+// channel flags replace global verbosity flags for that channel, set them before other threads log
+EXPORT void SetLogChannelFlags(const char* channel, const u8 flags);
+
+EXPORT void ClearLogChannelFlags(const char* channel);
+
+// colored stdout sink is added on startup, its flags can be changed by adding it again
+EXPORT b8 AddLogSink(const LogSink* p_sink);
+
+// sink is matched by write function and data
+EXPORT void RemoveLogSink(const LogSink* p_sink);
+
+EXPORT LogSink GetConsoleLogSink(void);
+
+EXPORT const char* GetLogVerbosityName(const LogVerbosity verbosity);
+
 void LogV(const LogVerbosity verbosity, const char* channel, const char* format, va_list list);
 
 void Log(const LogVerbosity verbosity, const char* channel, const char* format, ...);
 
-#define LogError(channel, format, ...) Log(LOG_VERBOSITY_ERROR, channel, format, ##__VA_ARGS__)
+// arguments are only evaluated if level is compiled in and enabled somewhere
+#define LogAt(verbosity, channel, format, ...)                                                      \
+    do                                                                                              \
+    {                                                                                               \
+        if ((verbosity) <= LOG_COMPILED_VERBOSITY && (logEnabledFlags & (1 << (verbosity))))        \
+        {                                                                                           \
+            Log(verbosity, channel, format, ##__VA_ARGS__);                                         \
+        }                                                                                           \
+    } while (0)
+
+#define LogError(channel, format, ...) LogAt(LOG_VERBOSITY_ERROR, channel, format, ##__VA_ARGS__)
 
-#define LogWarning(channel, format, ...) Log(LOG_VERBOSITY_WARNING, channel, format, ##__VA_ARGS__)
+#define LogWarning(channel, format, ...) LogAt(LOG_VERBOSITY_WARNING, channel, format, ##__VA_ARGS__)
 
-#define LogSuccess(channel, format, ...) Log(LOG_VERBOSITY_SUCCESS, channel, format, ##__VA_ARGS__)
+#define LogSuccess(channel, format, ...) LogAt(LOG_VERBOSITY_SUCCESS, channel, format, ##__VA_ARGS__)
 
-#define LogInfo(channel, format, ...) Log(LOG_VERBOSITY_INFO, channel, format, ##__VA_ARGS__)
+#define LogInfo(channel, format, ...) LogAt(LOG_VERBOSITY_INFO, channel, format, ##__VA_ARGS__)
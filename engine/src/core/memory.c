@@ -1,6 +1,8 @@
 #include "core/memory.h"
+#include "core/memory_profiler.h"
 #include "core/assert.h"
 #include "core/logger.h"
+#include "core/profiler.h"
 #include <stdatomic.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -9,11 +11,36 @@
 
 static MemoryTracker tracker = {};
 
-b8 StartupMemorySystem(void)
+static const char* tagNames[MEMORY_TAG_COUNT] =
+{ "Unknown", "Allocator", "Frame", "Events", "Window", "Renderer", "World" };
+
+static void TrackAllocation(MemoryTagCounters* p_counters, const u64 size);
+static void TrackFree(MemoryTagCounters* p_counters, const u64 size);
+static void LoadTagStats(const MemoryTagCounters* p_counters, MemoryTagStats* p_stats);
+
+b8 StartupMemorySystem(const u8 flags)
 {
+    PROFILE_FUNCTION();
+
     // make sure system is not started
     Assert(CHANNEL, tracker.isTracking == false, "System Is Already Initialized");
 
+    // startup call site profiler if it was requested
+    if ((flags & MEMORY_FLAG_PROFILE_ALLOCATIONS) && !StartupMemoryProfiler())
+    {
+        LogError(CHANNEL, "Memory Profiler Not Initialized");
+        return false;
+    }
+    tracker.flags = flags;
+    if (flags & MEMORY_FLAG_STRICT_FRAME_ALLOCATIONS)
+    {
+        tracker.flags |= MEMORY_FLAG_COUNT_FRAME_ALLOCATIONS;
+    }
+
+    // zero out frame counting
+    atomic_store(&tracker.frameAllocationCount, 0);
+    tracker.frames = (MemoryFrameStats){ 0 };
+
     // start tracking
     tracker.isTracking = true;
     LogSuccess(CHANNEL, SYSTEM_INITIALIZED_MESSAGE);
@@ -27,14 +54,37 @@ void ShutdownMemorySystem(void)
     // make sure system is started
     Assert(CHANNEL, tracker.isTracking == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
 
+    // report final breakdown
+    LogMemoryStats();
+
+    // report leaks and allocation hot spots
+    if (tracker.flags & MEMORY_FLAG_PROFILE_ALLOCATIONS)
+    {
+        LogMemoryProfile(MEMORY_PROFILE_DEFAULT_REPORT_COUNT);
+        ShutdownMemoryProfiler();
+    }
+
+    // report frames that were expected not to allocate
+    if (tracker.flags & MEMORY_FLAG_COUNT_FRAME_ALLOCATIONS)
+    {
+        if (tracker.frames.steadyAllocationCount > 0)
+        {
+            LogWarning(CHANNEL, "Steady Frames Allocated {Allocations: %lu, Frames: %lu Of %lu}",
+                    tracker.frames.steadyAllocationCount, tracker.frames.steadyAllocatingFrameCount, tracker.frames.frameCount);
+        }
+        else
+        {
+            LogSuccess(CHANNEL, "Steady Frames Did Not Allocate {Frames: %lu}", tracker.frames.frameCount);
+        }
+    }
+    tracker.flags = 0;
+
     // stop tracking
     tracker.isTracking = false;
     LogSuccess(CHANNEL, SYSTEM_TERMINATED_MESSAGE);
-    LogInfo(CHANNEL, "Total Allocated: %dB, Freed: %dB, Usage: %dB",
-            tracker.allocated, tracker.freed, tracker.usage);
 }
 
-void* AllocateMemory(const u32 size)
+void* AllocateMemoryAt(const u64 size, const u64 alignment, const MemoryTag tag, const char* file, const u32 line)
 {
     // make sure system is started
     Assert(CHANNEL, tracker.isTracking == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
@@ -42,26 +92,46 @@ void* AllocateMemory(const u32 size)
     // make sure size is not zero
     Assert(CHANNEL, size > 0, "Invalid Memory Size Provided");
 
-    // allocate memory on heap
-    void* newMemory = malloc(size);
+    // make sure alignment is zero (default) or power of two
+    Assert(CHANNEL, (alignment & (alignment - 1)) == 0, "Invalid Alignment Provided");
+
+    // make sure tag is valid
+    Assert(CHANNEL, tag < MEMORY_TAG_COUNT, "Invalid Memory Tag Provided");
+
+    // allocate memory on heap, aligned size must be multiple of alignment
+    void* newMemory = alignment == 0 ? malloc(size) : aligned_alloc(alignment, AlignUp(size, alignment));
 
     // track allocation if there are no errors
     if (newMemory)
     {
-        tracker.allocated += size;
-        tracker.usage += size;
-        LogSuccess(CHANNEL, "Allocated %dB Bytes On Heap", size);
+        TrackAllocation(&tracker.tags[tag], size);
+        TrackAllocation(&tracker.total, size);
+
+        // remember call site when profiling
+        if (tracker.flags & MEMORY_FLAG_PROFILE_ALLOCATIONS)
+        {
+            RecordProfiledAllocation(newMemory, size, tag, file, line);
+        }
+
+        // count allocation against current frame
+        if (tracker.flags & MEMORY_FLAG_COUNT_FRAME_ALLOCATIONS)
+        {
+            atomic_fetch_add_explicit(&tracker.frameAllocationCount, 1, memory_order_relaxed);
+            atomic_store_explicit(&tracker.frameAllocationFile, file, memory_order_relaxed);
+            atomic_store_explicit(&tracker.frameAllocationLine, line, memory_order_relaxed);
+        }
     }
     else 
     {
-        LogWarning(CHANNEL, "Failed To Allocate %dB Bytes On Heap", size);
+        LogWarning(CHANNEL, "Failed To Allocate %luB On Heap {Tag: %s, Site: %s:%d}",
+                size, tagNames[tag], file, line);
     }
 
-    // return allocated memory
+    // return allocated memory, it is freed with FreeMemory
     return newMemory;
 }
 
-void FreeMemory(void* memory, const u32 size)
+void FreeMemory(void* memory, const u64 size, const MemoryTag tag)
 {
     // make sure system is started
     Assert(CHANNEL, tracker.isTracking == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
@@ -72,19 +142,183 @@ void FreeMemory(void* memory, const u32 size)
     // make sure memory is not null
     Assert(CHANNEL, memory != null, "Invalud Memory Pointer Providede");
 
+    // make sure tag is valid
+    Assert(CHANNEL, tag < MEMORY_TAG_COUNT, "Invalid Memory Tag Provided");
+
+    // forget call site when profiling
+    if (tracker.flags & MEMORY_FLAG_PROFILE_ALLOCATIONS)
+    {
+        RecordProfiledFree(memory, size);
+    }
+
     // free memory
     free(memory);
 
     // track freeing
-    tracker.freed += size;
-    tracker.usage -= size;
+    TrackFree(&tracker.tags[tag], size);
+    TrackFree(&tracker.total, size);
+}
+
+void TrackMemoryAllocation(const u64 size, const MemoryTag tag)
+{
+    // make sure system is started
+    Assert(CHANNEL, tracker.isTracking == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // make sure tag is valid
+    Assert(CHANNEL, tag < MEMORY_TAG_COUNT, "Invalid Memory Tag Provided");
+
+    // count memory handed out by allocators that do not use heap
+    TrackAllocation(&tracker.tags[tag], size);
+    TrackAllocation(&tracker.total, size);
+}
+
+void TrackMemoryFree(const u64 size, const MemoryTag tag)
+{
+    // make sure system is started
+    Assert(CHANNEL, tracker.isTracking == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // make sure tag is valid
+    Assert(CHANNEL, tag < MEMORY_TAG_COUNT, "Invalid Memory Tag Provided");
+
+    // count memory given back to allocators that do not use heap
+    TrackFree(&tracker.tags[tag], size);
+    TrackFree(&tracker.total, size);
+}
+
+void EndMemoryFrame(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, tracker.isTracking == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // nothing to do if frames are not counted
+    if (!(tracker.flags & MEMORY_FLAG_COUNT_FRAME_ALLOCATIONS))
+    {
+        return;
+    }
+
+    // take allocations of frame that ended
+    u64 count = atomic_exchange_explicit(&tracker.frameAllocationCount, 0, memory_order_relaxed);
+    tracker.frames.lastFrameAllocationCount = count;
+
+    // frames past warm up should not allocate
+    if (count > 0 && tracker.frames.frameCount >= MEMORY_FRAME_WARMUP_COUNT)
+    {
+        tracker.frames.steadyAllocationCount += count;
+        tracker.frames.steadyAllocatingFrameCount++;
+
+        // strict mode stops on first such frame, otherwise it is reported once
+        const char* file = atomic_load_explicit(&tracker.frameAllocationFile, memory_order_relaxed);
+        u32 line = atomic_load_explicit(&tracker.frameAllocationLine, memory_order_relaxed);
+        if (tracker.flags & MEMORY_FLAG_STRICT_FRAME_ALLOCATIONS)
+        {
+            LogError(CHANNEL, "Steady Frame Allocated {Frame: %lu, Allocations: %lu, Last Site: %s:%d}",
+                    tracker.frames.frameCount, count, file, line);
+            Assert(CHANNEL, count == 0, "Steady Frame Allocated Memory");
+        }
+        else if (tracker.frames.steadyAllocatingFrameCount == 1)
+        {
+            LogWarning(CHANNEL, "Steady Frame Allocated {Frame: %lu, Allocations: %lu, Last Site: %s:%d}",
+                    tracker.frames.frameCount, count, file, line);
+        }
+    }
+
+    tracker.frames.frameCount++;
 }
 
-u32 GetCurrentMemoryUsage(void)
+void GetMemoryFrameStats(MemoryFrameStats* p_stats)
+{
+    // make sure system is started
+    Assert(CHANNEL, tracker.isTracking == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // check for invalid pointers
+    Assert(CHANNEL, p_stats != null, "Invalid Pointer Provided");
+
+    *p_stats = tracker.frames;
+}
+
+u64 GetCurrentMemoryUsage(void)
 {
     // make sure system is started
     Assert(CHANNEL, tracker.isTracking == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
 
     // return memory usage in bytes
-    return tracker.usage;
+    return atomic_load_explicit(&tracker.total.usage, memory_order_relaxed);
+}
+
+void GetMemoryStats(MemoryStats* p_stats)
+{
+    // make sure system is started
+    Assert(CHANNEL, tracker.isTracking == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // check for invalid pointers
+    Assert(CHANNEL, p_stats != null, "Invalid Pointer Provided");
+
+    // copy counters, every value is exact but they are not one snapshot
+    LoadTagStats(&tracker.total, &p_stats->total);
+    for (u8 i = 0; i < MEMORY_TAG_COUNT; i++)
+    {
+        LoadTagStats(&tracker.tags[i], &p_stats->tags[i]);
+    }
+}
+
+void LogMemoryStats(void)
+{
+    // get current stats
+    MemoryStats stats;
+    GetMemoryStats(&stats);
+
+    // log totals
+    LogInfo(CHANNEL, "Total Allocated: %luB, Freed: %luB, Usage: %luB, Peak: %luB, Allocations: %lu",
+            stats.total.allocated, stats.total.freed, stats.total.usage,
+            stats.total.peak, stats.total.allocationCount);
+
+    // log every tag that was used
+    for (u8 i = 0; i < MEMORY_TAG_COUNT; i++)
+    {
+        if (stats.tags[i].allocationCount == 0)
+        {
+            continue;
+        }
+
+        LogInfo(CHANNEL, "  %-10s Allocated: %luB, Freed: %luB, Usage: %luB, Peak: %luB, Allocations: %lu",
+                tagNames[i], stats.tags[i].allocated, stats.tags[i].freed, stats.tags[i].usage,
+                stats.tags[i].peak, stats.tags[i].allocationCount);
+    }
+}
+
+const char* GetMemoryTagName(const MemoryTag tag)
+{
+    // make sure tag is valid
+    Assert(CHANNEL, tag < MEMORY_TAG_COUNT, "Invalid Memory Tag Provided");
+
+    return tagNames[tag];
+}
+
+static void TrackAllocation(MemoryTagCounters* p_counters, const u64 size)
+{
+    // counters are independent, so relaxed ordering is enough
+    atomic_fetch_add_explicit(&p_counters->allocated, size, memory_order_relaxed);
+    atomic_fetch_add_explicit(&p_counters->allocationCount, 1, memory_order_relaxed);
+    u64 usage = atomic_fetch_add_explicit(&p_counters->usage, size, memory_order_relaxed) + size;
+
+    // raise high water mark if needed
+    u64 peak = atomic_load_explicit(&p_counters->peak, memory_order_relaxed);
+    while (usage > peak &&
+            !atomic_compare_exchange_weak_explicit(&p_counters->peak, &peak, usage,
+                memory_order_relaxed, memory_order_relaxed));
+}
+
+static void TrackFree(MemoryTagCounters* p_counters, const u64 size)
+{
+    atomic_fetch_add_explicit(&p_counters->freed, size, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&p_counters->usage, size, memory_order_relaxed);
+}
+
+static void LoadTagStats(const MemoryTagCounters* p_counters, MemoryTagStats* p_stats)
+{
+    p_stats->allocated = atomic_load_explicit(&p_counters->allocated, memory_order_relaxed);
+    p_stats->freed = atomic_load_explicit(&p_counters->freed, memory_order_relaxed);
+    p_stats->usage = atomic_load_explicit(&p_counters->usage, memory_order_relaxed);
+    p_stats->peak = atomic_load_explicit(&p_counters->peak, memory_order_relaxed);
+    p_stats->allocationCount = atomic_load_explicit(&p_counters->allocationCount, memory_order_relaxed);
 }
@@ -1,20 +1,101 @@
 #pragma once
 
 #include "defines.h"
+#include <stdatomic.h>
+
+#define DEFAULT_MEMORY_ALIGNMENT 16
+#define CACHE_LINE_SIZE 64
+
+#define MEMORY_FLAG_PROFILE_ALLOCATIONS 0x01
+
+// count heap allocations per frame, frames are ended by EndMemoryFrame
+#define MEMORY_FLAG_COUNT_FRAME_ALLOCATIONS 0x02
+
+// implies counting, asserts when frame past warm up allocates
+#define MEMORY_FLAG_STRICT_FRAME_ALLOCATIONS 0x04
+
+// frames that may allocate while caches and queues grow to their steady size
+#define MEMORY_FRAME_WARMUP_COUNT 60
+
+#define AlignUp(value, alignment) (((value) + ((alignment) - 1)) & ~((alignment) - 1))
+
+typedef enum MemoryTag {
+    MEMORY_TAG_UNKNOWN,
+    MEMORY_TAG_ALLOCATOR,
+    MEMORY_TAG_FRAME,
+    MEMORY_TAG_EVENTS,
+    MEMORY_TAG_WINDOW,
+    MEMORY_TAG_RENDERER,
+    MEMORY_TAG_WORLD,
+    MEMORY_TAG_COUNT
+} MemoryTag;
+
+typedef struct MemoryTagCounters {
+    _Atomic u64 allocated;
+    _Atomic u64 freed;
+    _Atomic u64 usage;
+    _Atomic u64 peak;
+    _Atomic u64 allocationCount;
+} MemoryTagCounters;
+
+typedef struct MemoryFrameStats {
+    u64 frameCount;
+    u64 lastFrameAllocationCount;
+    u64 steadyAllocationCount;          // allocations made by frames past warm up
+    u64 steadyAllocatingFrameCount;
+} MemoryFrameStats;
 
 typedef struct MemoryTracker {
     b8 isTracking;
-    u32 allocated;
-    u32 freed;
-    u32 usage;
+    u8 flags;
+    MemoryTagCounters total;
+    MemoryTagCounters tags[MEMORY_TAG_COUNT];
+
+    // allocations of current frame, last site tells where to look when steady frame allocates
+    _Atomic u64 frameAllocationCount;
+    _Atomic(const char*) frameAllocationFile;
+    _Atomic u32 frameAllocationLine;
+    MemoryFrameStats frames;
 } MemoryTracker;
 
-EXPORT b8 StartupMemorySystem(void);
+typedef struct MemoryTagStats {
+    u64 allocated;
+    u64 freed;
+    u64 usage;
+    u64 peak;
+    u64 allocationCount;
+} MemoryTagStats;
+
+typedef struct MemoryStats {
+    MemoryTagStats total;
+    MemoryTagStats tags[MEMORY_TAG_COUNT];
+} MemoryStats;
+
+EXPORT b8 StartupMemorySystem(const u8 flags);
 
 EXPORT void ShutdownMemorySystem(void);
 
-void* AllocateMemory(const u32 size);
+void* AllocateMemoryAt(const u64 size, const u64 alignment, const MemoryTag tag, const char* file, const u32 line);
+
+#define AllocateMemory(size, tag) AllocateMemoryAt(size, 0, tag, __FILE__, __LINE__)
+
+#define AllocateAlignedMemory(size, alignment, tag) AllocateMemoryAt(size, alignment, tag, __FILE__, __LINE__)
+
+void FreeMemory(void* memory, const u64 size, const MemoryTag tag);
+
+void TrackMemoryAllocation(const u64 size, const MemoryTag tag);
+
+void TrackMemoryFree(const u64 size, const MemoryTag tag);
+
+// marks frame boundary, called once per frame by engine loop
+EXPORT void EndMemoryFrame(void);
+
+EXPORT void GetMemoryFrameStats(MemoryFrameStats* p_stats);
+
+EXPORT u64 GetCurrentMemoryUsage(void);
+
+EXPORT void GetMemoryStats(MemoryStats* p_stats);
 
-void FreeMemory(void* memory, const u32 size);
+EXPORT void LogMemoryStats(void);
 
-u32 GetCurrentMemoryUsage(void);
+EXPORT const char* GetMemoryTagName(const MemoryTag tag);
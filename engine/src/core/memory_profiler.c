@@ -0,0 +1,304 @@
+#include "core/memory_profiler.h"
+#include "core/assert.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define CHANNEL "Memory Profiler"
+
+// both tables use open addressing with linear probing, capacities are powers of two
+// and they are allocated with raw calloc, so profiler never shows up in its own stats
+
+static b8 initialized = false;
+
+static atomic_flag lock = ATOMIC_FLAG_INIT;
+
+static MemoryProfileSite* sites;
+static u32 siteCount = 0;
+
+static MemoryProfileAllocation* allocations;
+static u32 allocationCount = 0;
+
+static u64 droppedCount = 0;
+
+static u64 GetTimestamp(void);
+static u32 HashKey(const u64 key, const u32 capacity);
+static u32 FindSite(const char* file, const u32 line, const MemoryTag tag);
+static int CompareSitesByBytes(const void* p_a, const void* p_b);
+static int CompareSitesByCount(const void* p_a, const void* p_b);
+static void LogTopSites(const char* title, int (*Compare)(const void*, const void*), const u32 count);
+
+b8 StartupMemoryProfiler(void)
+{
+    PROFILE_FUNCTION();
+
+    // make sure system is not started
+    Assert(CHANNEL, initialized == false, "System Is Already Initialized");
+
+    // allocate zeroed tables
+    sites = calloc(MEMORY_PROFILE_MAX_SITES, sizeof(MemoryProfileSite));
+    allocations = calloc(MEMORY_PROFILE_MAX_ALLOCATIONS, sizeof(MemoryProfileAllocation));
+
+    // check for allocation errors
+    if (!sites || !allocations)
+    {
+        LogError(CHANNEL, "Table Allocation Failed");
+        free(sites);
+        free(allocations);
+        return false;
+    }
+
+    // zero out counts
+    siteCount = 0;
+    allocationCount = 0;
+    droppedCount = 0;
+
+    // track system startup
+    initialized = true;
+    LogSuccess(CHANNEL, SYSTEM_INITIALIZED_MESSAGE);
+
+    // return success
+    return true;
+}
+
+void ShutdownMemoryProfiler(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // free tables
+    free(sites);
+    free(allocations);
+    sites = null;
+    allocations = null;
+
+    // track system shutdown
+    initialized = false;
+    LogSuccess(CHANNEL, SYSTEM_TERMINATED_MESSAGE);
+}
+
+void RecordProfiledAllocation(void* memory, const u64 size, const MemoryTag tag, const char* file, const u32 line)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // lock tables
+    while (atomic_flag_test_and_set_explicit(&lock, memory_order_acquire));
+
+    // find or insert call site
+    u32 site = FindSite(file, line, tag);
+    if (site == MEMORY_PROFILE_MAX_SITES)
+    {
+        droppedCount++;
+        atomic_flag_clear_explicit(&lock, memory_order_release);
+        return;
+    }
+
+    // update call site totals
+    sites[site].count++;
+    sites[site].bytes += size;
+
+    // keep live table at most half full, so probes stay short
+    if (allocationCount >= MEMORY_PROFILE_MAX_ALLOCATIONS / 2)
+    {
+        droppedCount++;
+        atomic_flag_clear_explicit(&lock, memory_order_release);
+        return;
+    }
+
+    // update call site live counters
+    sites[site].liveCount++;
+    sites[site].liveBytes += size;
+
+    // insert live allocation
+    u32 mask = MEMORY_PROFILE_MAX_ALLOCATIONS - 1;
+    u32 i = HashKey((uintptr_t)memory >> 4, MEMORY_PROFILE_MAX_ALLOCATIONS);
+    while (allocations[i].memory)
+    {
+        i = (i + 1) & mask;
+    }
+    allocations[i] = (MemoryProfileAllocation){ memory, size, GetTimestamp(), site };
+    allocationCount++;
+
+    // unlock tables
+    atomic_flag_clear_explicit(&lock, memory_order_release);
+}
+
+void RecordProfiledFree(void* memory, const u64 size)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // lock tables
+    while (atomic_flag_test_and_set_explicit(&lock, memory_order_acquire));
+
+    // find live allocation
+    u32 mask = MEMORY_PROFILE_MAX_ALLOCATIONS - 1;
+    u32 i = HashKey((uintptr_t)memory >> 4, MEMORY_PROFILE_MAX_ALLOCATIONS);
+    while (allocations[i].memory && allocations[i].memory != memory)
+    {
+        i = (i + 1) & mask;
+    }
+
+    // allocation may be dropped when tables were full
+    if (!allocations[i].memory)
+    {
+        atomic_flag_clear_explicit(&lock, memory_order_release);
+        return;
+    }
+
+    // catch frees with different size than allocation
+    if (allocations[i].size != size)
+    {
+        MemoryProfileSite* p_site = &sites[allocations[i].site];
+        LogWarning(CHANNEL, "Size Mismatch On Free {Allocated: %luB, Freed: %luB, Site: %s:%d}",
+                allocations[i].size, size, p_site->file, p_site->line);
+    }
+
+    // update call site
+    sites[allocations[i].site].liveCount--;
+    sites[allocations[i].site].liveBytes -= allocations[i].size;
+
+    // remove entry and shift following entries back, so probing never stops on a hole
+    u32 j = i;
+    while (true)
+    {
+        j = (j + 1) & mask;
+        if (!allocations[j].memory)
+        {
+            break;
+        }
+
+        // move entry if its home slot is not between hole and entry
+        u32 home = HashKey((uintptr_t)allocations[j].memory >> 4, MEMORY_PROFILE_MAX_ALLOCATIONS);
+        if (((j - home) & mask) >= ((j - i) & mask))
+        {
+            allocations[i] = allocations[j];
+            i = j;
+        }
+    }
+    allocations[i] = (MemoryProfileAllocation){};
+    allocationCount--;
+
+    // unlock tables
+    atomic_flag_clear_explicit(&lock, memory_order_release);
+}
+
+void LogMemoryProfile(const u32 count)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // lock tables
+    while (atomic_flag_test_and_set_explicit(&lock, memory_order_acquire));
+
+    // log live allocations, on shutdown these are leaks
+    u64 now = GetTimestamp();
+    LogInfo(CHANNEL, "Live Allocations: %d, Call Sites: %d, Dropped Records: %lu",
+            allocationCount, siteCount, droppedCount);
+    u32 logged = 0;
+    for (u32 i = 0; i < MEMORY_PROFILE_MAX_ALLOCATIONS && logged < count; i++)
+    {
+        if (!allocations[i].memory)
+        {
+            continue;
+        }
+
+        MemoryProfileSite* p_site = &sites[allocations[i].site];
+        LogWarning(CHANNEL, "  Live %luB {Tag: %s, Site: %s:%d, Age: %lums}",
+                allocations[i].size, GetMemoryTagName(p_site->tag), p_site->file, p_site->line,
+                (now - allocations[i].timestamp) / 1000000);
+        logged++;
+    }
+
+    // log allocation hot spots
+    LogTopSites("Top Call Sites By Bytes", CompareSitesByBytes, count);
+    LogTopSites("Top Call Sites By Count", CompareSitesByCount, count);
+
+    // unlock tables
+    atomic_flag_clear_explicit(&lock, memory_order_release);
+}
+
+static u64 GetTimestamp(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (u64)time.tv_sec * 1000000000 + time.tv_nsec;
+}
+
+static u32 HashKey(const u64 key, const u32 capacity)
+{
+    // fibonacci hashing
+    return (u32)((key * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+}
+
+static u32 FindSite(const char* file, const u32 line, const MemoryTag tag)
+{
+    // start from hashed slot
+    u32 mask = MEMORY_PROFILE_MAX_SITES - 1;
+    u32 i = HashKey((uintptr_t)file ^ ((u64)line << 32) ^ tag, MEMORY_PROFILE_MAX_SITES);
+
+    // probe until site or empty slot is found, file strings are compared by address
+    while (sites[i].file)
+    {
+        if (sites[i].file == file && sites[i].line == line && sites[i].tag == tag)
+        {
+            return i;
+        }
+        i = (i + 1) & mask;
+    }
+
+    // keep table at most half full
+    if (siteCount >= MEMORY_PROFILE_MAX_SITES / 2)
+    {
+        return MEMORY_PROFILE_MAX_SITES;
+    }
+
+    // insert new site
+    sites[i] = (MemoryProfileSite){ .file = file, .line = line, .tag = tag };
+    siteCount++;
+    return i;
+}
+
+static int CompareSitesByBytes(const void* p_a, const void* p_b)
+{
+    const MemoryProfileSite* p_siteA = &sites[*(const u16*)p_a];
+    const MemoryProfileSite* p_siteB = &sites[*(const u16*)p_b];
+    return (p_siteA->bytes < p_siteB->bytes) - (p_siteA->bytes > p_siteB->bytes);
+}
+
+static int CompareSitesByCount(const void* p_a, const void* p_b)
+{
+    const MemoryProfileSite* p_siteA = &sites[*(const u16*)p_a];
+    const MemoryProfileSite* p_siteB = &sites[*(const u16*)p_b];
+    return (p_siteA->count < p_siteB->count) - (p_siteA->count > p_siteB->count);
+}
+
+static void LogTopSites(const char* title, int (*Compare)(const void*, const void*), const u32 count)
+{
+    // collect used sites
+    u16 order[MEMORY_PROFILE_MAX_SITES];
+    u32 orderCount = 0;
+    for (u32 i = 0; i < MEMORY_PROFILE_MAX_SITES; i++)
+    {
+        if (sites[i].file)
+        {
+            order[orderCount++] = i;
+        }
+    }
+
+    // sort them in descending order
+    qsort(order, orderCount, sizeof(u16), Compare);
+
+    // log first few
+    LogInfo(CHANNEL, "%s:", title);
+    for (u32 i = 0; i < orderCount && i < count; i++)
+    {
+        MemoryProfileSite* p_site = &sites[order[i]];
+        LogInfo(CHANNEL, "  %s:%d {Tag: %s, Count: %lu, Bytes: %luB, Live: %lu (%luB)}",
+                p_site->file, p_site->line, GetMemoryTagName(p_site->tag),
+                p_site->count, p_site->bytes, p_site->liveCount, p_site->liveBytes);
+    }
+}
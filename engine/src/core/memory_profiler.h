@@ -0,0 +1,35 @@
+#pragma once
+
+#include "defines.h"
+#include "core/memory.h"
+
+#define MEMORY_PROFILE_MAX_SITES 1024
+#define MEMORY_PROFILE_MAX_ALLOCATIONS 65536
+#define MEMORY_PROFILE_DEFAULT_REPORT_COUNT 10
+
+typedef struct MemoryProfileSite {
+    const char* file;
+    u32 line;
+    MemoryTag tag;
+    u64 count;
+    u64 bytes;
+    u64 liveCount;
+    u64 liveBytes;
+} MemoryProfileSite;
+
+typedef struct MemoryProfileAllocation {
+    void* memory;
+    u64 size;
+    u64 timestamp;
+    u32 site;
+} MemoryProfileAllocation;
+
+b8 StartupMemoryProfiler(void);
+
+void ShutdownMemoryProfiler(void);
+
+void RecordProfiledAllocation(void* memory, const u64 size, const MemoryTag tag, const char* file, const u32 line);
+
+void RecordProfiledFree(void* memory, const u64 size);
+
+EXPORT void LogMemoryProfile(const u32 count);
@@ -0,0 +1,132 @@
+#include "core/mpsc_queue.h"
+#include "core/assert.h"
+#include "core/logger.h"
+#include <string.h>
+
+#define CHANNEL "MPSC Queue"
+
+// cell layout: [sequence][element], cells are rounded to alignment of sequence
+// sequence == position: cell is free for producer that claimed position
+// sequence == position + 1: cell holds element for consumer
+
+static _Atomic u32* GetCellSequence(const MPSCQueue* p_queue, const u32 position)
+{
+    return (_Atomic u32*)(p_queue->cells + (position & (p_queue->capacity - 1)) * p_queue->cellSize);
+}
+
+static void* GetCellElement(const MPSCQueue* p_queue, const u32 position)
+{
+    return p_queue->cells + (position & (p_queue->capacity - 1)) * p_queue->cellSize + sizeof(_Atomic u32);
+}
+
+b8 CreateMPSCQueue(MPSCQueue* p_queue, const u32 elementSize, const u32 capacity, const MemoryTag tag)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_queue != null, "Invalid Pointer Provided");
+
+    // make sure sizes are valid, capacity must be power of 2 for position wrapping
+    Assert(CHANNEL, elementSize > 0, "Invalid Element Size Provided");
+    Assert(CHANNEL, capacity > 0 && (capacity & (capacity - 1)) == 0, "Capacity Must Be Power Of 2");
+
+    // store sizes
+    p_queue->capacity = capacity;
+    p_queue->elementSize = elementSize;
+    p_queue->cellSize = AlignUp(sizeof(_Atomic u32) + elementSize, _Alignof(_Atomic u32));
+    p_queue->tag = tag;
+
+    // allocate cells on heap
+    p_queue->cells = AllocateAlignedMemory(capacity * p_queue->cellSize, CACHE_LINE_SIZE, tag);
+
+    // check for allocation errors
+    if (!p_queue->cells)
+    {
+        LogError(CHANNEL, "Cell Allocation Failed");
+        return false;
+    }
+
+    // every cell starts free for position it will be claimed at
+    for (u32 i = 0; i < capacity; i++)
+    {
+        atomic_init(GetCellSequence(p_queue, i), i);
+    }
+    atomic_init(&p_queue->tail, 0);
+    p_queue->head = 0;
+
+    // return success as default
+    LogSuccess(CHANNEL, "Queue Created {Element Size: %dB, Capacity: %d}", elementSize, capacity);
+    return true;
+}
+
+void DestroyMPSCQueue(MPSCQueue* p_queue)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_queue != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_queue->cells != null, "Invalid Pointer Provided");
+
+    // free cells
+    FreeMemory(p_queue->cells, p_queue->capacity * p_queue->cellSize, p_queue->tag);
+    p_queue->cells = null;
+    p_queue->capacity = 0;
+
+    LogSuccess(CHANNEL, "Queue Destroyed");
+}
+
+b8 PushMPSCQueue(MPSCQueue* p_queue, const void* p_element)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_queue != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_element != null, "Invalid Pointer Provided");
+
+    u32 position = atomic_load_explicit(&p_queue->tail, memory_order_relaxed);
+    while (true)
+    {
+        u32 sequence = atomic_load_explicit(GetCellSequence(p_queue, position), memory_order_acquire);
+        i32 difference = (i32)(sequence - position);
+
+        // cell is free, try to claim position
+        if (difference == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&p_queue->tail, &position, position + 1,
+                        memory_order_relaxed, memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        // consumer did not free cell yet, queue is full
+        else if (difference < 0)
+        {
+            return false;
+        }
+        // other producer claimed position, retry with new tail
+        else
+        {
+            position = atomic_load_explicit(&p_queue->tail, memory_order_relaxed);
+        }
+    }
+
+    // write element and hand cell to consumer
+    memcpy(GetCellElement(p_queue, position), p_element, p_queue->elementSize);
+    atomic_store_explicit(GetCellSequence(p_queue, position), position + 1, memory_order_release);
+    return true;
+}
+
+b8 PopMPSCQueue(MPSCQueue* p_queue, void* p_element)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_queue != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_element != null, "Invalid Pointer Provided");
+
+    // check if producer finished writing next cell
+    u32 position = p_queue->head;
+    _Atomic u32* p_sequence = GetCellSequence(p_queue, position);
+    if (atomic_load_explicit(p_sequence, memory_order_acquire) != position + 1)
+    {
+        return false;
+    }
+
+    // read element and free cell for producer one lap later
+    memcpy(p_element, GetCellElement(p_queue, position), p_queue->elementSize);
+    atomic_store_explicit(p_sequence, position + p_queue->capacity, memory_order_release);
+    p_queue->head = position + 1;
+    return true;
+}
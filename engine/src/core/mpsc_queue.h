@@ -0,0 +1,32 @@
+#pragma once
+
+#include "defines.h"
+#include "core/memory.h"
+#include <stdatomic.h>
+
+// bounded lock free queue, any thread can push, only one thread can pop
+// every cell has sequence number that tells producers and consumer whose turn it is
+typedef struct MPSCQueue {
+    // written by producers, kept on own cache line
+    _Alignas(CACHE_LINE_SIZE) _Atomic u32 tail;
+
+    // written by consumer only
+    _Alignas(CACHE_LINE_SIZE) u32 head;
+
+    // read only after creation
+    _Alignas(CACHE_LINE_SIZE) u32 capacity;
+    u32 elementSize;
+    u32 cellSize;
+    MemoryTag tag;
+    u8* cells;
+} MPSCQueue;
+
+b8 CreateMPSCQueue(MPSCQueue* p_queue, const u32 elementSize, const u32 capacity, const MemoryTag tag);
+
+void DestroyMPSCQueue(MPSCQueue* p_queue);
+
+// returns false when queue is full, safe to call from any thread
+b8 PushMPSCQueue(MPSCQueue* p_queue, const void* p_element);
+
+// returns false when queue is empty, only consumer thread can call it
+b8 PopMPSCQueue(MPSCQueue* p_queue, void* p_element);
@@ -0,0 +1,207 @@
+#include "core/pool_allocator.h"
+#include "core/memory.h"
+#include "core/assert.h"
+#include "core/logger.h"
+
+#define CHANNEL "Pool Allocator"
+
+// page layout: [slot 0][slot 1]...[slot N - 1][generation 0]...[generation N - 1]
+// free slots store index of next free slot in their first 4 bytes
+// generation is bumped on acquire and on release, odd generation means slot is live, even means it is free
+
+static b8 AddPoolPage(PoolAllocator* p_allocator);
+
+static void* GetSlotMemory(const PoolAllocator* p_allocator, const u32 index)
+{
+    return (char*)p_allocator->pages[index / p_allocator->slotsPerPage] +
+        (index % p_allocator->slotsPerPage) * p_allocator->slotSize;
+}
+
+static u32* GetSlotGeneration(const PoolAllocator* p_allocator, const u32 index)
+{
+    return (u32*)((char*)p_allocator->pages[index / p_allocator->slotsPerPage] +
+            p_allocator->slotsPerPage * p_allocator->slotSize) + index % p_allocator->slotsPerPage;
+}
+
+b8 CreatePoolAllocator(PoolAllocator* p_allocator, const u32 slotSize, const u32 slotsPerPage, const u32 maxPageCount, const MemoryTag tag)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+
+    // make sure sizes are greater than 0
+    Assert(CHANNEL, slotSize > 0, "Invalid Slot Size Provided");
+    Assert(CHANNEL, slotsPerPage > 0, "Invalid Slot Count Provided");
+    Assert(CHANNEL, maxPageCount > 0, "Invalid Page Count Provided");
+
+    // round slots to cache lines, so hot objects never share a line
+    p_allocator->slotSize = AlignUp(slotSize, CACHE_LINE_SIZE);
+    p_allocator->slotsPerPage = slotsPerPage;
+    p_allocator->pageSize = p_allocator->slotSize * slotsPerPage + sizeof(u32) * slotsPerPage;
+    p_allocator->pageCount = 0;
+    p_allocator->maxPageCount = maxPageCount;
+    p_allocator->usedSlotCount = 0;
+    p_allocator->freeHead = POOL_INVALID_INDEX;
+    p_allocator->tag = tag;
+
+    // allocate page table on heap
+    p_allocator->pages = AllocateMemory(maxPageCount * sizeof(void*), tag);
+
+    // check for allocation errors
+    if (!p_allocator->pages)
+    {
+        LogError(CHANNEL, "Page Table Allocation Failed");
+        return false;
+    }
+
+    // allocate first page up front
+    if (!AddPoolPage(p_allocator))
+    {
+        FreeMemory(p_allocator->pages, p_allocator->maxPageCount * sizeof(void*), p_allocator->tag);
+        p_allocator->pages = null;
+        return false;
+    }
+
+    // return success as default
+    LogSuccess(CHANNEL, "Allocator Created {Slot Size: %dB, Slots Per Page: %d, Max Pages: %d}",
+            p_allocator->slotSize, slotsPerPage, maxPageCount);
+    return true;
+}
+
+void DestroyPoolAllocator(PoolAllocator* p_allocator)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->pages != null, "Invalid Pointer Provided");
+
+    // check if all slots were released
+    if (p_allocator->usedSlotCount > 0)
+    {
+        LogWarning(CHANNEL, "Forgot To Release %d Slots", p_allocator->usedSlotCount);
+    }
+
+    // free pages and page table
+    for (u32 i = 0; i < p_allocator->pageCount; i++)
+    {
+        FreeMemory(p_allocator->pages[i], p_allocator->pageSize, p_allocator->tag);
+    }
+    FreeMemory(p_allocator->pages, p_allocator->maxPageCount * sizeof(void*), p_allocator->tag);
+    LogSuccess(CHANNEL, "Allocator Destroyed {Pages: %d, Page Size: %dB}",
+            p_allocator->pageCount, p_allocator->pageSize);
+
+    // zero out stuff
+    p_allocator->pages = null;
+    p_allocator->pageCount = 0;
+    p_allocator->usedSlotCount = 0;
+    p_allocator->freeHead = POOL_INVALID_INDEX;
+}
+
+void* AcquirePoolSlot(PoolAllocator* p_allocator, PoolHandle* p_handle)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->pages != null, "Allocator Is Not Created Yet");
+    Assert(CHANNEL, p_handle != null, "Invalid Pointer Provided");
+
+    // grow if there are no free slots left
+    if (p_allocator->freeHead == POOL_INVALID_INDEX && !AddPoolPage(p_allocator))
+    {
+        *p_handle = (PoolHandle){ POOL_INVALID_INDEX, 0 };
+        return null;
+    }
+
+    // pop slot from free list
+    u32 index = p_allocator->freeHead;
+    void* slot = GetSlotMemory(p_allocator, index);
+    p_allocator->freeHead = *(u32*)slot;
+    p_allocator->usedSlotCount++;
+
+    // mark slot live and fill handle
+    u32* p_generation = GetSlotGeneration(p_allocator, index);
+    (*p_generation)++;
+    p_handle->index = index;
+    p_handle->generation = *p_generation;
+
+    // return slot
+    return slot;
+}
+
+void ReleasePoolSlot(PoolAllocator* p_allocator, const PoolHandle handle)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->pages != null, "Allocator Is Not Created Yet");
+
+    // make sure handle is still alive, handles to free slots are rejected too, so slot is never freed twice
+    if (!GetPoolSlot(p_allocator, handle))
+    {
+        LogWarning(CHANNEL, "Stale Handle Released {Index: %d, Generation: %d}",
+                handle.index, handle.generation);
+        return;
+    }
+
+    // mark slot free, it invalidates every handle that points to it
+    (*GetSlotGeneration(p_allocator, handle.index))++;
+
+    // push slot to free list
+    *(u32*)GetSlotMemory(p_allocator, handle.index) = p_allocator->freeHead;
+    p_allocator->freeHead = handle.index;
+    p_allocator->usedSlotCount--;
+}
+
+void* GetPoolSlot(const PoolAllocator* p_allocator, const PoolHandle handle)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->pages != null, "Allocator Is Not Created Yet");
+
+    // make sure handle points to existing slot
+    if (handle.index >= p_allocator->pageCount * p_allocator->slotsPerPage)
+    {
+        return null;
+    }
+
+    // make sure handle is of live slot and slot was not released since handle was given
+    if (!(handle.generation & 1) || *GetSlotGeneration(p_allocator, handle.index) != handle.generation)
+    {
+        return null;
+    }
+
+    // return slot
+    return GetSlotMemory(p_allocator, handle.index);
+}
+
+static b8 AddPoolPage(PoolAllocator* p_allocator)
+{
+    // make sure allocator is allowed to grow
+    if (p_allocator->pageCount == p_allocator->maxPageCount)
+    {
+        LogError(CHANNEL, "Out Of Pages {Max Pages: %d}", p_allocator->maxPageCount);
+        return false;
+    }
+
+    // allocate cache line aligned page on heap
+    void* page = AllocateAlignedMemory(p_allocator->pageSize, CACHE_LINE_SIZE, p_allocator->tag);
+
+    // check for allocation errors
+    if (!page)
+    {
+        LogError(CHANNEL, "Page Allocation Failed");
+        return false;
+    }
+
+    // store page
+    u32 first = p_allocator->pageCount * p_allocator->slotsPerPage;
+    p_allocator->pages[p_allocator->pageCount++] = page;
+
+    // link page slots into free list in order, generations start even as slots are free, so zeroed handles are invalid
+    for (u32 i = 0; i < p_allocator->slotsPerPage; i++)
+    {
+        *(u32*)GetSlotMemory(p_allocator, first + i) =
+            i + 1 < p_allocator->slotsPerPage ? first + i + 1 : p_allocator->freeHead;
+        *GetSlotGeneration(p_allocator, first + i) = 0;
+    }
+    p_allocator->freeHead = first;
+
+    // return success
+    return true;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "defines.h"
+#include "core/memory.h"
+
+#define POOL_INVALID_INDEX UINT32_MAX
+
+typedef struct PoolHandle {
+    u32 index;
+    u32 generation;
+} PoolHandle;
+
+typedef struct PoolAllocator {
+    u32 slotSize;
+    u32 slotsPerPage;
+    u32 pageSize;
+    u32 pageCount;
+    u32 maxPageCount;
+    u32 usedSlotCount;
+    u32 freeHead;
+    MemoryTag tag;
+    void** pages;
+} PoolAllocator;
+
+b8 CreatePoolAllocator(PoolAllocator* p_allocator, const u32 slotSize, const u32 slotsPerPage, const u32 maxPageCount, const MemoryTag tag);
+
+void DestroyPoolAllocator(PoolAllocator* p_allocator);
+
+void* AcquirePoolSlot(PoolAllocator* p_allocator, PoolHandle* p_handle);
+
+void ReleasePoolSlot(PoolAllocator* p_allocator, const PoolHandle handle);
+
+void* GetPoolSlot(const PoolAllocator* p_allocator, const PoolHandle handle);
@@ -0,0 +1,213 @@
+#include "core/profiler.h"
+#include "core/assert.h"
+#include "core/logger.h"
+#include "platform/clock.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHANNEL "Profiler"
+
+// buffers are allocated with raw calloc, untouched pages of unused buffers never get memory
+typedef struct ProfileBuffer {
+    _Atomic u32 count;                  // written only by owning thread, exporter reads events below it
+    u32 droppedCount;
+    ProfileEvent* events;
+} ProfileBuffer;
+
+// zones read it on other threads
+static _Atomic b8 initialized = false;
+
+static u32 capacity = 0;
+static u64 startTime = 0;
+static ProfileEvent* events;
+static ProfileBuffer buffers[PROFILER_MAX_THREAD_COUNT];
+static _Atomic u32 bufferCount = 0;
+static _Thread_local ProfileBuffer* p_threadBuffer = null;
+static _Thread_local u32 threadGeneration = 0;
+static _Atomic u32 generation = 0;
+#if defined(DEBUG)
+static _Atomic u32 writerCount = 0;     // threads storing event right now, shutdown checks it
+#endif
+
+static void StoreProfileEvent(const ProfileZone* p_zone, const u64 end);
+
+b8 StartupProfiler(const u32 eventCapacity)
+{
+    // make sure system is not started
+    Assert(CHANNEL, initialized == false, "System Is Already Initialized");
+    Assert(CHANNEL, eventCapacity > 0, "Invalid Capacity Provided");
+
+    // allocate event storage for every thread at once
+    events = calloc((u64)PROFILER_MAX_THREAD_COUNT * eventCapacity, sizeof(ProfileEvent));
+    if (!events)
+    {
+        LogError(CHANNEL, "Event Allocation Failed");
+        return false;
+    }
+
+    // split storage between thread buffers
+    for (u32 i = 0; i < PROFILER_MAX_THREAD_COUNT; i++)
+    {
+        atomic_store(&buffers[i].count, 0);
+        buffers[i].droppedCount = 0;
+        buffers[i].events = events + (u64)i * eventCapacity;
+    }
+    capacity = eventCapacity;
+    atomic_store(&bufferCount, 0);
+
+    // new generation makes threads claim new buffers, old thread pointers belong to last startup
+    atomic_fetch_add(&generation, 1);
+    startTime = GetClockNanoseconds();
+
+    // track system startup
+    atomic_store(&initialized, true);
+    LogSuccess(CHANNEL, "%s {Capacity: %d Events Per Thread}", SYSTEM_INITIALIZED_MESSAGE, eventCapacity);
+
+    // return success
+    return true;
+}
+
+void ShutdownProfiler(void)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+
+    // zones still open are ignored, but no other thread may be closing one while storage is freed
+    atomic_store(&initialized, false);
+    Assert(CHANNEL, atomic_load(&writerCount) == 0, "Zone Closed During Shutdown");
+    free(events);
+    events = null;
+
+    // track system shutdown
+    LogSuccess(CHANNEL, SYSTEM_TERMINATED_MESSAGE);
+}
+
+b8 WriteProfilerTrace(const char* path)
+{
+    // make sure system is started
+    Assert(CHANNEL, initialized == true, SYSTEM_NOT_INITIALIZED_MESSAGE);
+    Assert(CHANNEL, path != null, "Invalid String Provided");
+
+    // open file
+    FILE* p_file = fopen(path, "w");
+    if (!p_file)
+    {
+        LogError(CHANNEL, "Trace File Not Opened {Path: %s}", path);
+        return false;
+    }
+
+    // name threads by buffer index, every buffer is its own track
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", p_file);
+    u32 threadCount = atomic_load(&bufferCount);
+    threadCount = threadCount < PROFILER_MAX_THREAD_COUNT ? threadCount : PROFILER_MAX_THREAD_COUNT;
+    u64 eventCount = 0;
+    u64 droppedCount = 0;
+    const char* separator = "";
+    for (u32 i = 0; i < threadCount; i++)
+    {
+        fprintf(p_file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Thread %d\"}}",
+                separator, i, i);
+        separator = ",\n";
+    }
+
+    // write closed zones as complete events, times are in microseconds
+    for (u32 i = 0; i < threadCount; i++)
+    {
+        ProfileBuffer* p_buffer = &buffers[i];
+        u32 count = atomic_load_explicit(&p_buffer->count, memory_order_acquire);
+        for (u32 j = 0; j < count; j++)
+        {
+            ProfileEvent* p_event = &p_buffer->events[j];
+            u64 start = p_event->start - startTime;
+            fprintf(p_file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%lu.%03lu,\"dur\":%lu.%03lu}",
+                    separator, p_event->name, i, start / 1000, start % 1000, p_event->duration / 1000, p_event->duration % 1000);
+            separator = ",\n";
+        }
+        eventCount += count;
+        droppedCount += p_buffer->droppedCount;
+    }
+    fputs("\n]}\n", p_file);
+
+    // close file
+    b8 isWritten = ferror(p_file) == 0;
+    if (fclose(p_file) != 0 || !isWritten)
+    {
+        LogError(CHANNEL, "Trace File Not Written {Path: %s}", path);
+        return false;
+    }
+
+    // dropped zones make trace incomplete
+    if (droppedCount > 0)
+    {
+        LogWarning(CHANNEL, "Event Buffers Were Full {Dropped: %lu}", droppedCount);
+    }
+
+    // return success as default
+    LogSuccess(CHANNEL, "Trace Written {Path: %s, Events: %lu, Threads: %d}", path, eventCount, threadCount);
+    return true;
+}
+
+ProfileZone BeginProfileZone(const char* name)
+{
+    // zones opened while profiler is down are ignored when closed
+    return (ProfileZone){
+        .name = atomic_load_explicit(&initialized, memory_order_relaxed) ? name : null,
+        .start = GetClockNanoseconds()
+    };
+}
+
+void EndProfileZone(ProfileZone* p_zone)
+{
+    // zone was opened while profiler was down
+    if (!p_zone->name)
+    {
+        return;
+    }
+    u64 end = GetClockNanoseconds();
+#if defined(DEBUG)
+    atomic_fetch_add(&writerCount, 1);
+#endif
+
+    // profiler may have gone down while zone was open
+    if (atomic_load(&initialized))
+    {
+        StoreProfileEvent(p_zone, end);
+    }
+#if defined(DEBUG)
+    atomic_fetch_sub(&writerCount, 1);
+#endif
+}
+
+static void StoreProfileEvent(const ProfileZone* p_zone, const u64 end)
+{
+    // take buffer of this thread, first zone of thread claims one
+    if (!p_threadBuffer || threadGeneration != atomic_load_explicit(&generation, memory_order_relaxed))
+    {
+        u32 index = atomic_fetch_add(&bufferCount, 1);
+        if (index >= PROFILER_MAX_THREAD_COUNT)
+        {
+            // no buffer left, this thread is not profiled
+            atomic_fetch_sub(&bufferCount, 1);
+            return;
+        }
+        p_threadBuffer = &buffers[index];
+        threadGeneration = atomic_load_explicit(&generation, memory_order_relaxed);
+    }
+
+    // drop event if buffer is full
+    u32 count = atomic_load_explicit(&p_threadBuffer->count, memory_order_relaxed);
+    if (count == capacity)
+    {
+        p_threadBuffer->droppedCount++;
+        return;
+    }
+
+    // store event, then publish it to exporter
+    p_threadBuffer->events[count] = (ProfileEvent){
+        .name = p_zone->name,
+        .start = p_zone->start,
+        .duration = end - p_zone->start
+    };
+    atomic_store_explicit(&p_threadBuffer->count, count + 1, memory_order_release);
+}
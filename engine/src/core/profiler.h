@@ -0,0 +1,46 @@
+#pragma once
+
+#include "defines.h"
+
+#define PROFILER_MAX_THREAD_COUNT 8
+
+// open zone, lives on stack of scope it measures
+typedef struct ProfileZone {
+    const char* name;
+    u64 start;
+} ProfileZone;
+
+// closed zone, written as chrome trace complete event
+typedef struct ProfileEvent {
+    const char* name;
+    u64 start;
+    u64 duration;
+} ProfileEvent;
+
+// every thread that records zones claims own buffer of event capacity, events past it are dropped
+EXPORT b8 StartupProfiler(const u32 eventCapacity);
+
+// other threads must have stopped closing zones, their buffers are freed here
+EXPORT void ShutdownProfiler(void);
+
+// writes chrome trace json, open it in perfetto or chrome://tracing
+EXPORT b8 WriteProfilerTrace(const char* path);
+
+// zone names must be static strings, only pointers are stored
+EXPORT ProfileZone BeginProfileZone(const char* name);
+
+EXPORT void EndProfileZone(ProfileZone* p_zone);
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// zones are only compiled in with -DPROFILING, zone ends when scope is left
+#if defined(PROFILING)
+    #define PROFILE_SCOPE(name)                                                                     \
+        ProfileZone PROFILE_CONCAT(profileZone, __LINE__) __attribute__((cleanup(EndProfileZone))) = \
+            BeginProfileZone(name)
+#else
+    #define PROFILE_SCOPE(name)
+#endif
+
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
@@ -2,10 +2,16 @@
 #include "core/memory.h"
 #include "core/assert.h"
 #include "core/logger.h"
+#include <string.h>
 
 #define CHANNEL "Stack Allocator"
 
-b8 CreateStackAllocator(StackAllocator* p_allocator, const u32 size)
+#if defined(STACK_ALLOCATOR_GUARDS)
+static StackAllocatorGuard GetTopGuard(const StackAllocator* p_allocator);
+static void CheckGuards(const StackAllocator* p_allocator, const StackAllocatorMarker marker);
+#endif
+
+b8 CreateStackAllocator(StackAllocator* p_allocator, const u32 size, const MemoryTag tag)
 {
     // check for invalid pointers
     Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
@@ -14,7 +20,7 @@ b8 CreateStackAllocator(StackAllocator* p_allocator, const u32 size)
     Assert(CHANNEL, size > 0, "Invalid Size Provided");
 
     // allocate memory on heap
-    p_allocator->memory = AllocateMemory(size);
+    p_allocator->memory = AllocateMemory(size, tag);
 
     // check for allocation errors
     if (!p_allocator->memory)
@@ -26,6 +32,8 @@ b8 CreateStackAllocator(StackAllocator* p_allocator, const u32 size)
     // init attributes
     p_allocator->size = size;
     p_allocator->used = 0;
+    p_allocator->peak = 0;
+    p_allocator->tag = tag;
 
     // return success as default
     LogSuccess(CHANNEL, "Allocator Created");
@@ -38,10 +46,15 @@ void DestroyStackAllocator(StackAllocator* p_allocator)
     Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
     Assert(CHANNEL, p_allocator->memory != null, "Invalid Pointer Provided");
 
+    // make sure nothing overran its memory
+#if defined(STACK_ALLOCATOR_GUARDS)
+    CheckGuards(p_allocator, 0);
+#endif
+
     // free memory
-    FreeMemory(p_allocator->memory, p_allocator->size);
-    LogSuccess(CHANNEL, "Allocator Destroyed {Size: %dB, Used: %dB}",
-            p_allocator->size, p_allocator->used);
+    FreeMemory(p_allocator->memory, p_allocator->size, p_allocator->tag);
+    LogSuccess(CHANNEL, "Allocator Destroyed {Size: %dB, Used: %dB, High Water Mark: %dB}",
+            p_allocator->size, p_allocator->used, p_allocator->peak);
 
     // check if all memory was freed
     if (p_allocator->used > 0)
@@ -52,10 +65,16 @@ void DestroyStackAllocator(StackAllocator* p_allocator)
     // zero out stuff
     p_allocator->memory = null;
     p_allocator->used = 0;
+    p_allocator->peak = 0;
     p_allocator->size = 0;
 }
 
 void* RequestStackAllocatorMemory(StackAllocator* p_allocator, const u32 size)
+{
+    return RequestStackAllocatorMemoryAligned(p_allocator, size, 1);
+}
+
+void* RequestStackAllocatorMemoryAligned(StackAllocator* p_allocator, const u32 size, const u32 alignment)
 {
     // check for invalid pointers
     Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
@@ -63,15 +82,43 @@ void* RequestStackAllocatorMemory(StackAllocator* p_allocator, const u32 size)
 
     // make sure size is greater than 0
     Assert(CHANNEL, size > 0, "Invalid Size Provieded");
-    
+
+    // make sure alignment is power of two
+    Assert(CHANNEL, alignment > 0 && (alignment & (alignment - 1)) == 0, "Invalid Alignment Provided");
+
+    // make sure previous allocation did not overrun its memory
+#if defined(STACK_ALLOCATOR_GUARDS)
+    GetTopGuard(p_allocator);
+    u32 guardSize = sizeof(StackAllocatorGuard);
+#else
+    u32 guardSize = 0;
+#endif
+
+    // align marker relative to real address, so base alignment does not matter
+    uintptr_t base = (uintptr_t)p_allocator->memory;
+    u32 offset = (u32)(AlignUp(base + p_allocator->used, (uintptr_t)alignment) - base);
+
     // make sure allocator is able to allocate that much memory
-    Assert(CHANNEL, size <= (p_allocator->size - p_allocator->used), "Too Much Memory Requested");
+    Assert(CHANNEL, offset <= p_allocator->size && size + guardSize <= p_allocator->size - offset,
+            "Too Much Memory Requested");
+
+    // write guard right after requested memory
+#if defined(STACK_ALLOCATOR_GUARDS)
+    StackAllocatorGuard guard = { STACK_ALLOCATOR_GUARD_CANARY, p_allocator->used, size };
+    memcpy((char*)p_allocator->memory + offset + size, &guard, sizeof(guard));
+#endif
 
     // move marker
-    p_allocator->used += size;
+    p_allocator->used = offset + size + guardSize;
+
+    // raise high water mark
+    if (p_allocator->used > p_allocator->peak)
+    {
+        p_allocator->peak = p_allocator->used;
+    }
 
     // return requested memory
-    return (char*)p_allocator->memory + p_allocator->used - size;
+    return (char*)p_allocator->memory + offset;
 }
 
 void FreeStackAllocatorMemory(StackAllocator* p_allocator, const u32 size)
@@ -82,10 +129,89 @@ void FreeStackAllocatorMemory(StackAllocator* p_allocator, const u32 size)
 
     // make sure size is greater than 0
     Assert(CHANNEL, size > 0, "Invalid Size Provided");
-    
+
+#if defined(STACK_ALLOCATOR_GUARDS)
+    // pop allocations one by one until requested size is freed, checking each guard
+    u32 freed = 0;
+    while (freed < size)
+    {
+        Assert(CHANNEL, p_allocator->used > 0, "Too Much Memory Requested");
+        StackAllocatorGuard guard = GetTopGuard(p_allocator);
+        freed += guard.size;
+        p_allocator->used = guard.previousUsed;
+    }
+    Assert(CHANNEL, freed == size, "Freed Size Does Not Match Requested Sizes");
+#else
     // make sure allocator is able to free that much memory
     Assert(CHANNEL, size <= p_allocator->used, "Too Much Memory Requested");
 
     // move marker
     p_allocator->used -= size;
+#endif
 }
+
+StackAllocatorMarker GetStackAllocatorMarker(const StackAllocator* p_allocator)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->memory != null, "Allocator Is Not Created Yet");
+
+    return p_allocator->used;
+}
+
+void FreeStackAllocatorToMarker(StackAllocator* p_allocator, const StackAllocatorMarker marker)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->memory != null, "Allocator Is Not Created Yet");
+
+    // make sure marker is not above top of stack
+    Assert(CHANNEL, marker <= p_allocator->used, "Invalid Marker Provided");
+
+    // make sure nothing above marker overran its memory
+#if defined(STACK_ALLOCATOR_GUARDS)
+    CheckGuards(p_allocator, marker);
+#endif
+
+    // move marker
+    p_allocator->used = marker;
+}
+
+#if defined(STACK_ALLOCATOR_GUARDS)
+
+static StackAllocatorGuard GetTopGuard(const StackAllocator* p_allocator)
+{
+    // empty stack has no guards
+    StackAllocatorGuard guard = {};
+    if (p_allocator->used == 0)
+    {
+        return guard;
+    }
+
+    // guard is last thing on stack
+    memcpy(&guard, (char*)p_allocator->memory + p_allocator->used - sizeof(guard), sizeof(guard));
+
+    // canary is right after memory, so overrun breaks it first
+    if (guard.canary != STACK_ALLOCATOR_GUARD_CANARY)
+    {
+        LogError(CHANNEL, "Memory Overrun Detected {Offset: %dB}", p_allocator->used - (u32)sizeof(guard));
+        DebugBreak();
+    }
+
+    return guard;
+}
+
+static void CheckGuards(const StackAllocator* p_allocator, const StackAllocatorMarker marker)
+{
+    // walk guards from top of stack down to marker
+    StackAllocator walker = *p_allocator;
+    while (walker.used > marker)
+    {
+        walker.used = GetTopGuard(&walker).previousUsed;
+    }
+
+    // marker must land on allocation boundary
+    Assert(CHANNEL, walker.used == marker, "Marker Is Not On Allocation Boundary");
+}
+
+#endif
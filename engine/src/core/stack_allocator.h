@@ -1,17 +1,49 @@
 #pragma once
 
 #include "defines.h"
+#include "core/memory.h"
+
+// in debug builds every allocation is followed by guard that catches overruns
+#if defined(DEBUG)
+    #define STACK_ALLOCATOR_GUARDS
+#endif
+
+#define STACK_ALLOCATOR_GUARD_CANARY 0xDEADC0DE
+
+typedef u32 StackAllocatorMarker;
+
+typedef struct StackAllocatorGuard {
+    u32 canary;
+    u32 previousUsed;
+    u32 size;
+} StackAllocatorGuard;
+
+// extra bytes every allocation takes, include it when sizing allocator
+#if defined(STACK_ALLOCATOR_GUARDS)
+    #define STACK_ALLOCATOR_GUARD_SIZE sizeof(StackAllocatorGuard)
+#else
+    #define STACK_ALLOCATOR_GUARD_SIZE 0
+#endif
 
 typedef struct StackAllocator {
     u32 size;
     u32 used;
+    u32 peak;
+    MemoryTag tag;
     void* memory;
 } StackAllocator;
 
-b8 CreateStackAllocator(StackAllocator* p_allocator, const u32 size);
+b8 CreateStackAllocator(StackAllocator* p_allocator, const u32 size, const MemoryTag tag);
 
 void DestroyStackAllocator(StackAllocator* p_allocator);
 
 void* RequestStackAllocatorMemory(StackAllocator* p_allocator, const u32 size);
 
+void* RequestStackAllocatorMemoryAligned(StackAllocator* p_allocator, const u32 size, const u32 alignment);
+
+// only valid for memory requested without alignment, use markers otherwise
 void FreeStackAllocatorMemory(StackAllocator* p_allocator, const u32 size);
+
+StackAllocatorMarker GetStackAllocatorMarker(const StackAllocator* p_allocator);
+
+void FreeStackAllocatorToMarker(StackAllocator* p_allocator, const StackAllocatorMarker marker);
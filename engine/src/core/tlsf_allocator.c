@@ -0,0 +1,444 @@
+#include "core/tlsf_allocator.h"
+#include "core/assert.h"
+#include "core/logger.h"
+
+#define CHANNEL "TLSF Allocator"
+
+// every block starts with 16B header, payload follows it
+// free blocks keep free list links in first 16B of payload
+// size field stores payload size, its low bits are used as flags
+#define BLOCK_HEADER_SIZE (sizeof(TLSFBlock*) + sizeof(u64))
+#define BLOCK_MIN_SIZE (2 * sizeof(TLSFBlock*))
+#define BLOCK_FLAG_FREE 0x1
+#define BLOCK_FLAG_PREV_FREE 0x2
+#define BLOCK_FLAGS (BLOCK_FLAG_FREE | BLOCK_FLAG_PREV_FREE)
+
+static u64 GetBlockSize(const TLSFBlock* p_block);
+static void SetBlockSize(TLSFBlock* p_block, const u64 size);
+static void* GetBlockPayload(const TLSFBlock* p_block);
+static TLSFBlock* GetPayloadBlock(const void* payload);
+static TLSFBlock* GetNextBlock(const TLSFBlock* p_block);
+static void MarkBlockFree(TLSFBlock* p_block);
+static void MarkBlockUsed(TLSFBlock* p_block);
+static void MapSize(const u64 size, u32* p_fl, u32* p_sl);
+static TLSFBlock* FindFreeBlock(TLSFAllocator* p_allocator, const u64 size);
+static void InsertFreeBlock(TLSFAllocator* p_allocator, TLSFBlock* p_block);
+static void RemoveFreeBlock(TLSFAllocator* p_allocator, TLSFBlock* p_block);
+static TLSFBlock* SplitBlock(TLSFBlock* p_block, const u64 size);
+static TLSFBlock* MergeBlocks(TLSFBlock* p_prev, TLSFBlock* p_block);
+static void* UseBlock(TLSFAllocator* p_allocator, TLSFBlock* p_block, const u64 size);
+
+b8 CreateTLSFAllocator(TLSFAllocator* p_allocator, void* memory, const u64 size, const MemoryTag tag)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, memory != null, "Invalid Pointer Provided");
+
+    // align region start and size, so every block is aligned
+    char* start = (char*)AlignUp((uintptr_t)memory, TLSF_ALIGNMENT);
+    u64 usable = (size - (start - (char*)memory)) & ~(u64)(TLSF_ALIGNMENT - 1);
+
+    // region must hold first block, its payload and last sentinel block
+    if (size < TLSF_ALIGNMENT + 2 * BLOCK_HEADER_SIZE + BLOCK_MIN_SIZE ||
+            usable - 2 * BLOCK_HEADER_SIZE >= ((u64)1 << TLSF_FL_INDEX_MAX))
+    {
+        LogError(CHANNEL, "Invalid Region Size Provided: %luB", size);
+        return false;
+    }
+
+    // init attributes
+    *p_allocator = (TLSFAllocator){ .memory = memory, .size = size, .tag = tag };
+
+    // create one big free block
+    TLSFBlock* p_block = (TLSFBlock*)start;
+    p_block->prevPhysical = null;
+    p_block->size = 0;
+    SetBlockSize(p_block, usable - 2 * BLOCK_HEADER_SIZE);
+    MarkBlockFree(p_block);
+    InsertFreeBlock(p_allocator, p_block);
+
+    // create zero sized used sentinel at the end, so merging never walks out of region
+    TLSFBlock* p_sentinel = GetNextBlock(p_block);
+    p_sentinel->prevPhysical = p_block;
+    p_sentinel->size = BLOCK_FLAG_PREV_FREE;
+
+    // return success as default
+    LogSuccess(CHANNEL, "Allocator Created {Size: %luB, Usable: %luB}", size, GetBlockSize(p_block));
+    return true;
+}
+
+void DestroyTLSFAllocator(TLSFAllocator* p_allocator)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->memory != null, "Allocator Is Not Created Yet");
+
+    LogSuccess(CHANNEL, "Allocator Destroyed {Size: %luB, Used: %luB, Peak: %luB}",
+            p_allocator->size, p_allocator->used, p_allocator->peak);
+
+    // check if all memory was freed
+    if (p_allocator->allocationCount > 0)
+    {
+        LogWarning(CHANNEL, "Forgot To Free %d Allocations (%luB)",
+                p_allocator->allocationCount, p_allocator->used);
+        TrackMemoryFree(p_allocator->used, p_allocator->tag);
+    }
+
+    // zero out stuff, region belongs to caller
+    *p_allocator = (TLSFAllocator){};
+}
+
+void* RequestTLSFMemory(TLSFAllocator* p_allocator, const u64 size)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->memory != null, "Allocator Is Not Created Yet");
+
+    // make sure size is greater than 0
+    Assert(CHANNEL, size > 0, "Invalid Size Provided");
+
+    // round size up to block granularity
+    u64 adjusted = AlignUp(size, TLSF_ALIGNMENT);
+    if (adjusted < BLOCK_MIN_SIZE)
+    {
+        adjusted = BLOCK_MIN_SIZE;
+    }
+
+    // find free block and return it
+    TLSFBlock* p_block = FindFreeBlock(p_allocator, adjusted);
+    if (!p_block)
+    {
+        LogError(CHANNEL, "Out Of Memory {Size: %luB, Used: %luB, Requested: %luB}",
+                p_allocator->size, p_allocator->used, size);
+        return null;
+    }
+    return UseBlock(p_allocator, p_block, adjusted);
+}
+
+void* RequestTLSFMemoryAligned(TLSFAllocator* p_allocator, const u64 size, const u64 alignment)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->memory != null, "Allocator Is Not Created Yet");
+
+    // make sure size is greater than 0
+    Assert(CHANNEL, size > 0, "Invalid Size Provided");
+
+    // make sure alignment is power of two
+    Assert(CHANNEL, alignment > 0 && (alignment & (alignment - 1)) == 0, "Invalid Alignment Provided");
+
+    // every payload is already aligned this much
+    if (alignment <= TLSF_ALIGNMENT)
+    {
+        return RequestTLSFMemory(p_allocator, size);
+    }
+
+    // round size up to block granularity
+    u64 adjusted = AlignUp(size, TLSF_ALIGNMENT);
+    if (adjusted < BLOCK_MIN_SIZE)
+    {
+        adjusted = BLOCK_MIN_SIZE;
+    }
+
+    // ask for enough space to split off leading gap as its own free block
+    u64 gapMin = BLOCK_HEADER_SIZE + BLOCK_MIN_SIZE;
+    TLSFBlock* p_block = FindFreeBlock(p_allocator, adjusted + alignment + gapMin);
+    if (!p_block)
+    {
+        LogError(CHANNEL, "Out Of Memory {Size: %luB, Used: %luB, Requested: %luB Aligned To %luB}",
+                p_allocator->size, p_allocator->used, size, alignment);
+        return null;
+    }
+
+    // find aligned payload, gap before it must fit free block or be empty
+    uintptr_t payload = (uintptr_t)GetBlockPayload(p_block);
+    uintptr_t aligned = AlignUp(payload, alignment);
+    if (aligned != payload && aligned - payload < gapMin)
+    {
+        aligned = AlignUp(payload + gapMin, alignment);
+    }
+
+    // split gap into its own free block
+    if (aligned != payload)
+    {
+        TLSFBlock* p_alignedBlock = SplitBlock(p_block, aligned - payload - BLOCK_HEADER_SIZE);
+        InsertFreeBlock(p_allocator, p_block);
+        p_block = p_alignedBlock;
+    }
+
+    // use aligned block
+    return UseBlock(p_allocator, p_block, adjusted);
+}
+
+void FreeTLSFMemory(TLSFAllocator* p_allocator, void* memory)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->memory != null, "Allocator Is Not Created Yet");
+    Assert(CHANNEL, memory != null, "Invalid Pointer Provided");
+
+    // get block of memory
+    TLSFBlock* p_block = GetPayloadBlock(memory);
+
+    // make sure block is not freed twice
+    Assert(CHANNEL, !(p_block->size & BLOCK_FLAG_FREE), "Memory Is Already Freed");
+
+    // track freeing
+    u64 size = GetBlockSize(p_block);
+    p_allocator->used -= size;
+    p_allocator->allocationCount--;
+    TrackMemoryFree(size, p_allocator->tag);
+
+    // mark block free
+    MarkBlockFree(p_block);
+
+    // merge with previous block if it is free
+    if (p_block->size & BLOCK_FLAG_PREV_FREE)
+    {
+        TLSFBlock* p_prev = p_block->prevPhysical;
+        RemoveFreeBlock(p_allocator, p_prev);
+        p_block = MergeBlocks(p_prev, p_block);
+    }
+
+    // merge with next block if it is free
+    TLSFBlock* p_next = GetNextBlock(p_block);
+    if (p_next->size & BLOCK_FLAG_FREE)
+    {
+        RemoveFreeBlock(p_allocator, p_next);
+        p_block = MergeBlocks(p_block, p_next);
+    }
+
+    // give block back
+    InsertFreeBlock(p_allocator, p_block);
+}
+
+void GetTLSFStats(const TLSFAllocator* p_allocator, TLSFStats* p_stats)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_allocator != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_allocator->memory != null, "Allocator Is Not Created Yet");
+    Assert(CHANNEL, p_stats != null, "Invalid Pointer Provided");
+
+    // fill known values
+    *p_stats = (TLSFStats){
+        .used = p_allocator->used,
+        .peak = p_allocator->peak,
+        .allocationCount = p_allocator->allocationCount
+    };
+
+    // walk free lists
+    for (u32 fl = 0; fl < TLSF_FL_INDEX_COUNT; fl++)
+    {
+        for (u32 sl = 0; sl < TLSF_SL_INDEX_COUNT; sl++)
+        {
+            for (TLSFBlock* p_block = p_allocator->freeLists[fl][sl]; p_block; p_block = p_block->nextFree)
+            {
+                u64 size = GetBlockSize(p_block);
+                p_stats->free += size;
+                p_stats->freeBlockCount++;
+                if (size > p_stats->largestFreeBlock)
+                {
+                    p_stats->largestFreeBlock = size;
+                }
+            }
+        }
+    }
+
+    // free memory that is not in largest block is fragmented
+    if (p_stats->free > 0)
+    {
+        p_stats->fragmentation = 1.0f - (f32)p_stats->largestFreeBlock / (f32)p_stats->free;
+    }
+}
+
+static u64 GetBlockSize(const TLSFBlock* p_block)
+{
+    return p_block->size & ~(u64)BLOCK_FLAGS;
+}
+
+static void SetBlockSize(TLSFBlock* p_block, const u64 size)
+{
+    p_block->size = size | (p_block->size & BLOCK_FLAGS);
+}
+
+static void* GetBlockPayload(const TLSFBlock* p_block)
+{
+    return (char*)p_block + BLOCK_HEADER_SIZE;
+}
+
+static TLSFBlock* GetPayloadBlock(const void* payload)
+{
+    return (TLSFBlock*)((char*)payload - BLOCK_HEADER_SIZE);
+}
+
+static TLSFBlock* GetNextBlock(const TLSFBlock* p_block)
+{
+    return (TLSFBlock*)((char*)GetBlockPayload(p_block) + GetBlockSize(p_block));
+}
+
+static void MarkBlockFree(TLSFBlock* p_block)
+{
+    p_block->size |= BLOCK_FLAG_FREE;
+
+    // let next block know it can merge with us
+    TLSFBlock* p_next = GetNextBlock(p_block);
+    p_next->prevPhysical = p_block;
+    p_next->size |= BLOCK_FLAG_PREV_FREE;
+}
+
+static void MarkBlockUsed(TLSFBlock* p_block)
+{
+    p_block->size &= ~(u64)BLOCK_FLAG_FREE;
+    GetNextBlock(p_block)->size &= ~(u64)BLOCK_FLAG_PREV_FREE;
+}
+
+static void MapSize(const u64 size, u32* p_fl, u32* p_sl)
+{
+    // small blocks are linearly spread in first list
+    if (size < TLSF_SMALL_BLOCK_SIZE)
+    {
+        *p_fl = 0;
+        *p_sl = (u32)size / (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT);
+        return;
+    }
+
+    // first level is power of two, second level splits it linearly
+    u32 bit = 63 - __builtin_clzll(size);
+    *p_sl = (u32)(size >> (bit - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+    *p_fl = bit - (TLSF_FL_INDEX_SHIFT - 1);
+}
+
+static TLSFBlock* FindFreeBlock(TLSFAllocator* p_allocator, const u64 size)
+{
+    // round size up to next list, so any block in found list is big enough
+    u64 rounded = size;
+    if (size >= TLSF_SMALL_BLOCK_SIZE)
+    {
+        rounded += ((u64)1 << (63 - __builtin_clzll(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+
+    // map size to list indices
+    u32 fl, sl;
+    MapSize(rounded, &fl, &sl);
+    if (fl >= TLSF_FL_INDEX_COUNT)
+    {
+        return null;
+    }
+
+    // search same first level list for big enough second level list
+    u32 slMap = p_allocator->slBitmaps[fl] & (~0u << sl);
+    if (!slMap)
+    {
+        // search bigger first level lists
+        u32 flMap = fl + 1 < 32 ? p_allocator->flBitmap & (~0u << (fl + 1)) : 0;
+        if (!flMap)
+        {
+            return null;
+        }
+        fl = __builtin_ctz(flMap);
+        slMap = p_allocator->slBitmaps[fl];
+    }
+    sl = __builtin_ctz(slMap);
+
+    // take first block from that list
+    TLSFBlock* p_block = p_allocator->freeLists[fl][sl];
+    RemoveFreeBlock(p_allocator, p_block);
+    return p_block;
+}
+
+static void InsertFreeBlock(TLSFAllocator* p_allocator, TLSFBlock* p_block)
+{
+    // push block to head of its list
+    u32 fl, sl;
+    MapSize(GetBlockSize(p_block), &fl, &sl);
+    TLSFBlock* p_head = p_allocator->freeLists[fl][sl];
+    p_block->nextFree = p_head;
+    p_block->prevFree = null;
+    if (p_head)
+    {
+        p_head->prevFree = p_block;
+    }
+    p_allocator->freeLists[fl][sl] = p_block;
+
+    // mark list as not empty
+    p_allocator->flBitmap |= 1u << fl;
+    p_allocator->slBitmaps[fl] |= 1u << sl;
+}
+
+static void RemoveFreeBlock(TLSFAllocator* p_allocator, TLSFBlock* p_block)
+{
+    // unlink block from its list
+    u32 fl, sl;
+    MapSize(GetBlockSize(p_block), &fl, &sl);
+    if (p_block->prevFree)
+    {
+        p_block->prevFree->nextFree = p_block->nextFree;
+    }
+    else
+    {
+        p_allocator->freeLists[fl][sl] = p_block->nextFree;
+    }
+    if (p_block->nextFree)
+    {
+        p_block->nextFree->prevFree = p_block->prevFree;
+    }
+
+    // mark list as empty if it was last block
+    if (!p_allocator->freeLists[fl][sl])
+    {
+        p_allocator->slBitmaps[fl] &= ~(1u << sl);
+        if (!p_allocator->slBitmaps[fl])
+        {
+            p_allocator->flBitmap &= ~(1u << fl);
+        }
+    }
+}
+
+static TLSFBlock* SplitBlock(TLSFBlock* p_block, const u64 size)
+{
+    // cut remainder right after first size bytes of payload
+    TLSFBlock* p_remainder = (TLSFBlock*)((char*)GetBlockPayload(p_block) + size);
+    p_remainder->size = 0;
+    SetBlockSize(p_remainder, GetBlockSize(p_block) - size - BLOCK_HEADER_SIZE);
+    SetBlockSize(p_block, size);
+
+    // link remainder physically, it is free and its previous block is free as well
+    p_remainder->prevPhysical = p_block;
+    p_remainder->size |= BLOCK_FLAG_PREV_FREE;
+    MarkBlockFree(p_remainder);
+    return p_remainder;
+}
+
+static TLSFBlock* MergeBlocks(TLSFBlock* p_prev, TLSFBlock* p_block)
+{
+    // absorb block with its header into previous block
+    SetBlockSize(p_prev, GetBlockSize(p_prev) + BLOCK_HEADER_SIZE + GetBlockSize(p_block));
+    GetNextBlock(p_prev)->prevPhysical = p_prev;
+    return p_prev;
+}
+
+static void* UseBlock(TLSFAllocator* p_allocator, TLSFBlock* p_block, const u64 size)
+{
+    // give tail back if it is big enough to be its own block
+    if (GetBlockSize(p_block) >= size + BLOCK_HEADER_SIZE + BLOCK_MIN_SIZE)
+    {
+        TLSFBlock* p_remainder = SplitBlock(p_block, size);
+        InsertFreeBlock(p_allocator, p_remainder);
+    }
+
+    // mark block used
+    MarkBlockUsed(p_block);
+
+    // track allocation
+    u64 blockSize = GetBlockSize(p_block);
+    p_allocator->used += blockSize;
+    p_allocator->allocationCount++;
+    if (p_allocator->used > p_allocator->peak)
+    {
+        p_allocator->peak = p_allocator->used;
+    }
+    TrackMemoryAllocation(blockSize, p_allocator->tag);
+
+    // return payload
+    return GetBlockPayload(p_block);
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "defines.h"
+#include "core/memory.h"
+
+#define TLSF_SL_INDEX_COUNT_LOG2 5
+#define TLSF_SL_INDEX_COUNT (1 << TLSF_SL_INDEX_COUNT_LOG2)
+#define TLSF_ALIGNMENT_LOG2 4
+#define TLSF_ALIGNMENT (1 << TLSF_ALIGNMENT_LOG2)
+#define TLSF_FL_INDEX_MAX 32
+#define TLSF_FL_INDEX_SHIFT (TLSF_SL_INDEX_COUNT_LOG2 + TLSF_ALIGNMENT_LOG2)
+#define TLSF_FL_INDEX_COUNT (TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1)
+#define TLSF_SMALL_BLOCK_SIZE (1 << TLSF_FL_INDEX_SHIFT)
+
+typedef struct TLSFBlock {
+    struct TLSFBlock* prevPhysical;
+    u64 size;
+    struct TLSFBlock* nextFree;
+    struct TLSFBlock* prevFree;
+} TLSFBlock;
+
+typedef struct TLSFAllocator {
+    void* memory;
+    u64 size;
+    u64 used;
+    u64 peak;
+    u32 allocationCount;
+    MemoryTag tag;
+    u32 flBitmap;
+    u32 slBitmaps[TLSF_FL_INDEX_COUNT];
+    TLSFBlock* freeLists[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+} TLSFAllocator;
+
+typedef struct TLSFStats {
+    u64 used;
+    u64 free;
+    u64 peak;
+    u64 largestFreeBlock;
+    u32 freeBlockCount;
+    u32 allocationCount;
+    f32 fragmentation;
+} TLSFStats;
+
+// memory must not come from AllocateMemory, requests are already counted under tag
+b8 CreateTLSFAllocator(TLSFAllocator* p_allocator, void* memory, const u64 size, const MemoryTag tag);
+
+void DestroyTLSFAllocator(TLSFAllocator* p_allocator);
+
+void* RequestTLSFMemory(TLSFAllocator* p_allocator, const u64 size);
+
+void* RequestTLSFMemoryAligned(TLSFAllocator* p_allocator, const u64 size, const u64 alignment);
+
+void FreeTLSFMemory(TLSFAllocator* p_allocator, void* memory);
+
+void GetTLSFStats(const TLSFAllocator* p_allocator, TLSFStats* p_stats);
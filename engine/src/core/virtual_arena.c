@@ -0,0 +1,129 @@
+#include "core/virtual_arena.h"
+#include "core/memory.h"
+#include "core/assert.h"
+#include "core/logger.h"
+#include "platform/virtual_memory.h"
+
+#define CHANNEL "Virtual Arena"
+
+// commit this much at once, so we do not call into kernel on every request
+#define VIRTUAL_ARENA_COMMIT_SIZE (64 * 1024)
+
+b8 CreateVirtualArena(VirtualArena* p_arena, const u64 reserveSize, const u8 flags)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_arena != null, "Invalid Pointer Provided");
+
+    // make sure size is greater than 0
+    Assert(CHANNEL, reserveSize > 0, "Invalid Size Provided");
+
+    // commit whole huge pages when they are requested, so commits never split them
+    p_arena->granularity = (flags & (VIRTUAL_MEMORY_FLAG_HUGE_PAGES | VIRTUAL_MEMORY_FLAG_HUGETLB)) ?
+        HUGE_PAGE_SIZE : VIRTUAL_ARENA_COMMIT_SIZE;
+
+    // make sure granularity is multiple of system page size
+    p_arena->granularity = AlignUp(p_arena->granularity, GetVirtualMemoryPageSize());
+
+    // reserve address space
+    p_arena->reserved = AlignUp(reserveSize, p_arena->granularity);
+    p_arena->memory = ReserveVirtualMemory(p_arena->reserved, flags);
+
+    // check for reservation errors
+    if (!p_arena->memory)
+    {
+        LogError(CHANNEL, "Address Space Reservation Failed");
+        return false;
+    }
+
+    // init attributes
+    p_arena->committed = 0;
+    p_arena->used = 0;
+    p_arena->peak = 0;
+
+    // return success as default
+    LogSuccess(CHANNEL, "Arena Created {Reserved: %luB, Commit Granularity: %luB}",
+            p_arena->reserved, p_arena->granularity);
+    return true;
+}
+
+void DestroyVirtualArena(VirtualArena* p_arena)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_arena != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_arena->memory != null, "Invalid Pointer Provided");
+
+    // release address space with all committed pages
+    ReleaseVirtualMemory(p_arena->memory, p_arena->reserved);
+    LogSuccess(CHANNEL, "Arena Destroyed {Reserved: %luB, Peak: %luB}",
+            p_arena->reserved, p_arena->peak);
+
+    // zero out stuff
+    p_arena->memory = null;
+    p_arena->reserved = 0;
+    p_arena->committed = 0;
+    p_arena->used = 0;
+    p_arena->peak = 0;
+}
+
+void* RequestVirtualArenaMemory(VirtualArena* p_arena, const u64 size, const u64 alignment)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_arena != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_arena->memory != null, "Arena Is Not Created Yet");
+
+    // make sure size is greater than 0
+    Assert(CHANNEL, size > 0, "Invalid Size Provided");
+
+    // make sure alignment is power of two
+    Assert(CHANNEL, alignment > 0 && (alignment & (alignment - 1)) == 0, "Invalid Alignment Provided");
+
+    // arena base is page aligned, so aligning offset is enough
+    u64 offset = AlignUp(p_arena->used, alignment);
+
+    // check if reserved range is big enough
+    if (offset > p_arena->reserved || size > p_arena->reserved - offset)
+    {
+        LogError(CHANNEL, "Out Of Reserved Memory {Reserved: %luB, Used: %luB, Requested: %luB}",
+                p_arena->reserved, p_arena->used, size);
+        return null;
+    }
+
+    // commit more pages if request goes past committed range
+    if (offset + size > p_arena->committed)
+    {
+        u64 newCommitted = AlignUp(offset + size, p_arena->granularity);
+        if (!CommitVirtualMemory((char*)p_arena->memory + p_arena->committed, newCommitted - p_arena->committed))
+        {
+            LogError(CHANNEL, "Page Commit Failed");
+            return null;
+        }
+        p_arena->committed = newCommitted;
+    }
+
+    // move marker
+    p_arena->used = offset + size;
+    if (p_arena->used > p_arena->peak)
+    {
+        p_arena->peak = p_arena->used;
+    }
+
+    // return requested memory
+    return (char*)p_arena->memory + offset;
+}
+
+void ResetVirtualArena(VirtualArena* p_arena)
+{
+    // check for invalid pointers
+    Assert(CHANNEL, p_arena != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_arena->memory != null, "Arena Is Not Created Yet");
+
+    // give committed pages back to system
+    if (p_arena->committed > 0)
+    {
+        DecommitVirtualMemory(p_arena->memory, p_arena->committed);
+    }
+
+    // move marker back to the start
+    p_arena->committed = 0;
+    p_arena->used = 0;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "defines.h"
+
+typedef struct VirtualArena {
+    u64 reserved;
+    u64 committed;
+    u64 used;
+    u64 peak;
+    u64 granularity;
+    void* memory;
+} VirtualArena;
+
+b8 CreateVirtualArena(VirtualArena* p_arena, const u64 reserveSize, const u8 flags);
+
+void DestroyVirtualArena(VirtualArena* p_arena);
+
+void* RequestVirtualArenaMemory(VirtualArena* p_arena, const u64 size, const u64 alignment);
+
+void ResetVirtualArena(VirtualArena* p_arena);
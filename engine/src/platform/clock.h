@@ -0,0 +1,9 @@
+#pragma once
+
+#include "defines.h"
+
+// monotonic time, only differences between two calls are meaningful
+EXPORT u64 GetClockNanoseconds(void);
+
+// wall clock time since unix epoch, can jump when system time changes
+EXPORT u64 GetWallClockNanoseconds(void);
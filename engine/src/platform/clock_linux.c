@@ -0,0 +1,21 @@
+#include "platform/clock.h"
+
+#if defined(PLATFORM_LINUX)
+
+#include <time.h>
+
+u64 GetClockNanoseconds(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (u64)time.tv_sec * 1000000000 + time.tv_nsec;
+}
+
+u64 GetWallClockNanoseconds(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_REALTIME, &time);
+    return (u64)time.tv_sec * 1000000000 + time.tv_nsec;
+}
+
+#endif
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "defines.h"
+
+typedef struct FileMap {
+    i32 handle;
+    u64 size;
+    void* memory;
+} FileMap;
+
+// creates or truncates file, grows it to size and maps it writable
+// disk blocks are reserved, so writes can not fail, except on filesystems without fallocate, where it warns
+b8 CreateFileMap(FileMap* p_map, const char* path, const u64 size);
+
+// unmaps file and cuts it to used size, so preallocated tail is not left behind
+void DestroyFileMap(FileMap* p_map, const u64 usedSize);
+
+b8 RenameFile(const char* path, const char* newPath);
+
+b8 FileExists(const char* path);
+
+// cuts zero bytes off end of file, for files left mapped by process that did not reach DestroyFileMap
+b8 TrimFileZeroTail(const char* path);
@@ -0,0 +1,133 @@
+#include "platform/file_map.h"
+
+#if defined(PLATFORM_LINUX)
+
+#define CHANNEL "Linux File Map"
+
+#include "core/assert.h"
+#include "core/logger.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+b8 CreateFileMap(FileMap* p_map, const char* path, const u64 size)
+{
+    // check params for invalid pointers
+    Assert(CHANNEL, p_map != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, path != null, "Invalid String Provided");
+
+    // make sure size is not zero
+    Assert(CHANNEL, size > 0, "Invalid Size Provided");
+
+    // open file and check for errors
+    p_map->handle = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (p_map->handle < 0)
+    {
+        LogError(CHANNEL, "File Not Opened {Path: %s}", path);
+        return false;
+    }
+
+    // reserve disk blocks up front, so writes never hit sigbus on full disk
+    // filesystems without fallocate get sparse file instead, it works, but full disk raises sigbus on write
+    i32 result = posix_fallocate(p_map->handle, 0, size);
+    if (result != 0)
+    {
+        if (ftruncate(p_map->handle, size) != 0)
+        {
+            LogError(CHANNEL, "File Not Resized {Path: %s, Size: %luB}", path, size);
+            close(p_map->handle);
+            return false;
+        }
+        LogWarning(CHANNEL, "File Blocks Not Reserved, Full Disk Will Raise SIGBUS {Path: %s, Error: %d}", path, result);
+    }
+
+    // map file
+    p_map->memory = mmap(null, size, PROT_READ | PROT_WRITE, MAP_SHARED, p_map->handle, 0);
+    if (p_map->memory == MAP_FAILED)
+    {
+        LogError(CHANNEL, "File Not Mapped {Path: %s, Size: %luB}", path, size);
+        close(p_map->handle);
+        p_map->memory = null;
+        return false;
+    }
+
+    p_map->size = size;
+    return true;
+}
+
+void DestroyFileMap(FileMap* p_map, const u64 usedSize)
+{
+    // check params for invalid pointers
+    Assert(CHANNEL, p_map != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, p_map->memory != null, "Invalid Pointer Provided");
+
+    // unmap, cut unused tail and close file
+    munmap(p_map->memory, p_map->size);
+    if (ftruncate(p_map->handle, usedSize) != 0)
+    {
+        LogWarning(CHANNEL, "File Not Truncated {Size: %luB}", usedSize);
+    }
+    close(p_map->handle);
+
+    p_map->memory = null;
+    p_map->size = 0;
+    p_map->handle = -1;
+}
+
+b8 RenameFile(const char* path, const char* newPath)
+{
+    return rename(path, newPath) == 0;
+}
+
+b8 FileExists(const char* path)
+{
+    return access(path, F_OK) == 0;
+}
+
+b8 TrimFileZeroTail(const char* path)
+{
+    // check params for invalid pointers
+    Assert(CHANNEL, path != null, "Invalid String Provided");
+
+    // open file and get its size
+    i32 handle = open(path, O_RDWR);
+    struct stat info;
+    if (handle < 0 || fstat(handle, &info) != 0)
+    {
+        if (handle >= 0)
+        {
+            close(handle);
+        }
+        return false;
+    }
+
+    // empty file has nothing to trim
+    if (info.st_size == 0)
+    {
+        close(handle);
+        return true;
+    }
+
+    // find last non zero byte
+    u8* memory = mmap(null, info.st_size, PROT_READ, MAP_SHARED, handle, 0);
+    if (memory == MAP_FAILED)
+    {
+        close(handle);
+        return false;
+    }
+    u64 size = info.st_size;
+    while (size > 0 && memory[size - 1] == 0)
+    {
+        size--;
+    }
+    munmap(memory, info.st_size);
+
+    // cut zero tail
+    b8 result = ftruncate(handle, size) == 0;
+    close(handle);
+    return result;
+}
+
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "defines.h"
+
+typedef void* (*ThreadFunction)(void* p_data);
+
+typedef struct Thread {
+    u64 handle;
+} Thread;
+
+typedef void (*ThreadExitCallback)(void* p_data);
+
+// one hook serves every thread, each thread arms it with own data
+typedef struct ThreadExitHook {
+    u64 handle;
+} ThreadExitHook;
+
+b8 CreateThread(Thread* p_thread, ThreadFunction function, void* p_data);
+
+void JoinThread(Thread* p_thread);
+
+void SleepThread(const u32 microseconds);
+
+b8 CreateThreadExitHook(ThreadExitHook* p_hook, ThreadExitCallback callback);
+
+// callback runs with data when calling thread exits, main thread returning from main does not count
+void ArmThreadExitHook(const ThreadExitHook* p_hook, void* p_data);
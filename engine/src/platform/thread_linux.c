@@ -0,0 +1,72 @@
+#include "platform/thread.h"
+
+#if defined(PLATFORM_LINUX)
+
+#define CHANNEL "Linux Thread"
+
+#include "core/assert.h"
+#include <pthread.h>
+#include <time.h>
+
+b8 CreateThread(Thread* p_thread, ThreadFunction function, void* p_data)
+{
+    // check params for invalid pointers
+    Assert(CHANNEL, p_thread != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, function != null, "Invalid Pointer Provided");
+
+    // start thread, handle is pthread id
+    pthread_t thread;
+    if (pthread_create(&thread, null, function, p_data) != 0)
+    {
+        return false;
+    }
+
+    p_thread->handle = (u64)thread;
+    return true;
+}
+
+void JoinThread(Thread* p_thread)
+{
+    // check params for invalid pointers
+    Assert(CHANNEL, p_thread != null, "Invalid Pointer Provided");
+
+    // wait for thread to return
+    pthread_join((pthread_t)p_thread->handle, null);
+    p_thread->handle = 0;
+}
+
+void SleepThread(const u32 microseconds)
+{
+    struct timespec time = {
+        .tv_sec = microseconds / 1000000,
+        .tv_nsec = (microseconds % 1000000) * 1000
+    };
+    nanosleep(&time, null);
+}
+
+b8 CreateThreadExitHook(ThreadExitHook* p_hook, ThreadExitCallback callback)
+{
+    // check params for invalid pointers
+    Assert(CHANNEL, p_hook != null, "Invalid Pointer Provided");
+    Assert(CHANNEL, callback != null, "Invalid Pointer Provided");
+
+    // key destructor runs for every thread that set non null value
+    pthread_key_t key;
+    if (pthread_key_create(&key, callback) != 0)
+    {
+        return false;
+    }
+
+    p_hook->handle = key;
+    return true;
+}
+
+void ArmThreadExitHook(const ThreadExitHook* p_hook, void* p_data)
+{
+    // check params for invalid pointers
+    Assert(CHANNEL, p_hook != null, "Invalid Pointer Provided");
+
+    pthread_setspecific((pthread_key_t)p_hook->handle, p_data);
+}
+
+#endif
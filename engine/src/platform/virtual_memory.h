@@ -0,0 +1,18 @@
+#pragma once
+
+#include "defines.h"
+
+#define VIRTUAL_MEMORY_FLAG_HUGE_PAGES 0x01
+#define VIRTUAL_MEMORY_FLAG_HUGETLB 0x02
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+u64 GetVirtualMemoryPageSize(void);
+
+void* ReserveVirtualMemory(const u64 size, const u8 flags);
+
+void ReleaseVirtualMemory(void* memory, const u64 size);
+
+b8 CommitVirtualMemory(void* memory, const u64 size);
+
+void DecommitVirtualMemory(void* memory, const u64 size);
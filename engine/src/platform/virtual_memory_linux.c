@@ -0,0 +1,129 @@
+#include "platform/virtual_memory.h"
+
+#if defined(PLATFORM_LINUX)
+
+#define CHANNEL "Linux Virtual Memory"
+
+#include "core/assert.h"
+#include "core/logger.h"
+#include <sys/mman.h>
+#include <unistd.h>
+
+u64 GetVirtualMemoryPageSize(void)
+{
+    return (u64)sysconf(_SC_PAGESIZE);
+}
+
+static void* ReserveNormalPages(const u64 size, const u8 flags);
+
+void* ReserveVirtualMemory(const u64 size, const u8 flags)
+{
+    // make sure size is not zero
+    Assert(CHANNEL, size > 0, "Invalid Size Provided");
+
+    // store reserved address range here
+    void* memory = MAP_FAILED;
+
+    // try explicit huge pages first, they need preallocated hugetlbfs pool
+    // no MAP_NORESERVE here, so empty pool fails now instead of raising sigbus on first touch
+    if (flags & VIRTUAL_MEMORY_FLAG_HUGETLB)
+    {
+        memory = mmap(null, size, PROT_NONE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (memory == MAP_FAILED)
+        {
+            LogWarning(CHANNEL, "Huge TLB Pages Not Available, Falling Back To Normal Pages");
+        }
+    }
+
+    // reserve address range without backing pages
+    if (memory == MAP_FAILED)
+    {
+        memory = ReserveNormalPages(size, flags);
+    }
+
+    // check for reservation errors
+    if (memory == MAP_FAILED)
+    {
+        LogError(CHANNEL, "Failed To Reserve %luB Of Address Space", size);
+        return null;
+    }
+
+    // ask kernel to back range with transparent huge pages
+    if ((flags & VIRTUAL_MEMORY_FLAG_HUGE_PAGES) && madvise(memory, size, MADV_HUGEPAGE) != 0)
+    {
+        LogWarning(CHANNEL, "Transparent Huge Pages Not Available");
+    }
+
+    // return reserved range
+    return memory;
+}
+
+static void* ReserveNormalPages(const u64 size, const u8 flags)
+{
+    // normal pages only need page alignment
+    if (!(flags & VIRTUAL_MEMORY_FLAG_HUGE_PAGES))
+    {
+        return mmap(null, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    }
+
+    // reserve extra huge page, so range can start on huge page boundary and no huge page is cut at its ends
+    u64 paddedSize = size + HUGE_PAGE_SIZE;
+    u8* padded = mmap(null, paddedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (padded == MAP_FAILED)
+    {
+        return MAP_FAILED;
+    }
+
+    // trim padding before and after aligned range
+    u8* memory = (u8*)(((u64)padded + HUGE_PAGE_SIZE - 1) & ~((u64)HUGE_PAGE_SIZE - 1));
+    u64 headSize = memory - padded;
+    u64 tailSize = paddedSize - headSize - size;
+    if (headSize > 0)
+    {
+        munmap(padded, headSize);
+    }
+    if (tailSize > 0)
+    {
+        munmap(memory + size, tailSize);
+    }
+    return memory;
+}
+
+void ReleaseVirtualMemory(void* memory, const u64 size)
+{
+    // make sure memory is not null
+    Assert(CHANNEL, memory != null, "Invalid Memory Pointer Provided");
+
+    // unmap whole range
+    munmap(memory, size);
+}
+
+b8 CommitVirtualMemory(void* memory, const u64 size)
+{
+    // make sure memory is not null
+    Assert(CHANNEL, memory != null, "Invalid Memory Pointer Provided");
+
+    // make pages accessible, kernel backs them on first touch
+    if (mprotect(memory, size, PROT_READ | PROT_WRITE) != 0)
+    {
+        LogError(CHANNEL, "Failed To Commit %luB", size);
+        return false;
+    }
+
+    // return success
+    return true;
+}
+
+void DecommitVirtualMemory(void* memory, const u64 size)
+{
+    // make sure memory is not null
+    Assert(CHANNEL, memory != null, "Invalid Memory Pointer Provided");
+
+    // give physical pages back to kernel and make range inaccessible again
+    madvise(memory, size, MADV_DONTNEED);
+    mprotect(memory, size, PROT_NONE);
+}
+
+#endif
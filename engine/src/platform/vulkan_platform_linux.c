@@ -2,14 +2,15 @@
 
 #if defined(PLATFORM_LINUX)
 
-#include "platform/window_linux.h"
+#include "platform/window_xlib.h"
+#include "platform/window_xcb.h"
 #include "core/logger.h"
 
 #define CHANNEL "Vulkan Linux"
 
 const char** GetVKInstanceExtensions(u8* p_count)
 {
-    static const char* exts[] = 
+    static const char* xlibExts[] = 
     {
         "VK_KHR_surface",
         "VK_KHR_xlib_surface",
@@ -19,26 +20,56 @@ const char** GetVKInstanceExtensions(u8* p_count)
 #endif
 
     };
+    static const char* xcbExts[] = 
+    {
+        "VK_KHR_surface",
+        "VK_KHR_xcb_surface",
+
+#if defined(DEBUG)
+        "VK_EXT_debug_utils"
+#endif
+
+    };
+
+    // only surface extension of window backend in use is needed
+    if (GetWindowBackend() == WINDOW_BACKEND_XCB)
+    {
+        *p_count = sizeof(xcbExts) / sizeof(char*);
+        return xcbExts;
+    }
 
     // calculate ext count dynamcly
-    *p_count = sizeof(exts) / sizeof(char*);
+    *p_count = sizeof(xlibExts) / sizeof(char*);
 
     // return filled exts array
-    return exts;
+    return xlibExts;
 }
 
 b8 CreateVKSurface(const VkInstance instance, VkSurfaceKHR* p_surface)
 {
-    // surface info
-    VkXlibSurfaceCreateInfoKHR surfaceInfo =
-    {
-        .sType = VK_STRUCTURE_TYPE_XLIB_SURFACE_CREATE_INFO_KHR,
-        .dpy = GetLinuxWindowDisplay(),
-        .window = GetLinuxWindowHandle()
-    };
+    VkResult result;
 
-    // create surface
-    VkResult result = vkCreateXlibSurfaceKHR(instance, &surfaceInfo, null, p_surface);
+    // create surface for window backend in use
+    if (GetWindowBackend() == WINDOW_BACKEND_XCB)
+    {
+        VkXcbSurfaceCreateInfoKHR surfaceInfo =
+        {
+            .sType = VK_STRUCTURE_TYPE_XCB_SURFACE_CREATE_INFO_KHR,
+            .connection = GetXcbWindowConnection(),
+            .window = GetXcbWindowHandle()
+        };
+        result = vkCreateXcbSurfaceKHR(instance, &surfaceInfo, null, p_surface);
+    }
+    else
+    {
+        VkXlibSurfaceCreateInfoKHR surfaceInfo =
+        {
+            .sType = VK_STRUCTURE_TYPE_XLIB_SURFACE_CREATE_INFO_KHR,
+            .dpy = GetXlibWindowDisplay(),
+            .window = GetXlibWindowHandle()
+        };
+        result = vkCreateXlibSurfaceKHR(instance, &surfaceInfo, null, p_surface);
+    }
 
     // check if surface was created
     if (result != VK_SUCCESS)
@@ -9,10 +9,26 @@ typedef struct WindowSize {
     u16 height;
 } WindowSize;
 
-EXPORT b8 CreateWindow(const u16 width, const u16 height, const char* title);
+typedef enum WindowBackend {
+    WINDOW_BACKEND_XLIB,
+    WINDOW_BACKEND_XCB                  // polls events without implicit round trips
+} WindowBackend;
+
+EXPORT b8 CreateWindow(const WindowBackend backend, const u16 width, const u16 height, const char* title);
 
 EXPORT void DestroyWindow(void);
 
 EXPORT void FireWindowEvents(void);
 
 EXPORT WindowSize GetWindowSize(void);
+
+EXPORT WindowBackend GetWindowBackend(void);
+
+// grabbed cursor can not leave window and all pointer input goes to it, returns false if server refused grab
+EXPORT b8 SetWindowCursorGrab(const b8 isGrabbed);
+
+// moves window event handling to own thread, so input is read and timestamped while frame is busy
+// while it runs, FireWindowEvents does nothing and window events reach event system thro PostEvent
+EXPORT b8 StartWindowInputThread(void);
+
+EXPORT void StopWindowInputThread(void);
@@ -5,171 +5,203 @@
 #define CHANNEL "Linux Window"
 
 #include "platform/window_linux.h"
-#include "core/assert.h"
+#include "platform/window_xlib.h"
+#include "platform/window_xcb.h"
+#include "platform/thread.h"
 #include "core/logger.h"
-#include "core/memory.h"
-#include "core/event.h"
-#include <X11/Xutil.h>
+#include "core/input.h"
+#include <stdatomic.h>
 
-static LinuxWindow* window = null;
+static LinuxWindowBackend backend;
 
-EXPORT b8 CreateWindow(const u16 width, const u16 height, const char* title)
-{
-    // allocate structure on heap
-    window = AllocateMemory(sizeof(LinuxWindow));
+// input thread state
+static _Atomic b8 isInputThreadRunning = false;
+static Thread inputThread;
+static _Thread_local b8 isInputThread = false;
+
+// raw motion held on input thread, frame count is bumped by main thread, motion is sent once it changes
+static MouseMotionEventPayload heldMotion;
+static u64 sentMotionFrame = 0;
+static _Atomic u64 frameCount = 0;
+static _Atomic b8 isMotionHeld = false;
 
-    // check if singleton was allocated
-    if (!window)
+void FlushWindowInput(const MouseMotionEventPayload* p_motion)
+{
+    // main thread batch is already once per frame
+    if (!isInputThread)
     {
-        LogError(CHANNEL, "Singleton Allocation Failed");
-        return false;
+        if (p_motion->sampleCount > 0)
+        {
+            MoveInputMouse(p_motion->deltaX, p_motion->deltaY, p_motion->timestamp);
+            FireEvent(EVENT_TYPE_MOUSE_MOTION, p_motion, sizeof(MouseMotionEventPayload));
+        }
+        PublishInput();
+        return;
     }
 
-    // create display
-    window->display = XOpenDisplay(null);
+    // hold motion of this batch with motion not sent yet
+    heldMotion.deltaX += p_motion->deltaX;
+    heldMotion.deltaY += p_motion->deltaY;
+    heldMotion.sampleCount += p_motion->sampleCount;
+    heldMotion.timestamp = p_motion->sampleCount > 0 ? p_motion->timestamp : heldMotion.timestamp;
 
-    // check if display was created
-    if (!window->display)
+    // send held motion once per frame, keys and buttons are published right away
+    u64 frame = atomic_load_explicit(&frameCount, memory_order_relaxed);
+    if (heldMotion.sampleCount > 0 && frame != sentMotionFrame)
     {
-        LogError(CHANNEL, "Display Creation Failed");
-        return false;
+        MoveInputMouse(heldMotion.deltaX, heldMotion.deltaY, heldMotion.timestamp);
+        PostEvent(EVENT_TYPE_MOUSE_MOTION, &heldMotion, sizeof(heldMotion));
+        heldMotion = (MouseMotionEventPayload){ 0 };
+        sentMotionFrame = frame;
     }
+    atomic_store_explicit(&isMotionHeld, heldMotion.sampleCount > 0, memory_order_relaxed);
+    PublishInput();
+}
 
-    // get screen
-    window->screen = DefaultScreen(window->display);
-
-    // get root window
-    window->root = RootWindow(window->display, window->screen);
+static void* RunInputThread(void* p_data);
 
-    // create window
-    window->handle = XCreateSimpleWindow
-        (
-         window->display, 
-         window->root, 
-         0, 0, 
-         width, height, 
-         0, 0, 0
-         );
+EXPORT b8 CreateWindow(const WindowBackend type, const u16 width, const u16 height, const char* title)
+{
+    // check backend and asign function pointers
+    switch (type)
+    {
+        case WINDOW_BACKEND_XLIB:
+            backend.Create = CreateXlibWindow;
+            backend.Destroy = DestroyXlibWindow;
+            backend.FireEvents = FireXlibWindowEvents;
+            backend.Wake = WakeXlibWindow;
+            backend.GetSize = GetXlibWindowSize;
+            backend.SetCursorGrab = SetXlibWindowCursorGrab;
+            LogInfo(CHANNEL, "Backend Choosen: \"%s\"", "Xlib");
+            break;
+        case WINDOW_BACKEND_XCB:
+            backend.Create = CreateXcbWindow;
+            backend.Destroy = DestroyXcbWindow;
+            backend.FireEvents = FireXcbWindowEvents;
+            backend.Wake = WakeXcbWindow;
+            backend.GetSize = GetXcbWindowSize;
+            backend.SetCursorGrab = SetXcbWindowCursorGrab;
+            LogInfo(CHANNEL, "Backend Choosen: \"%s\"", "XCB");
+            break;
+        default:
+            LogError(CHANNEL, "Invalid Backend Provided");
+            return false;
+    }
+    backend.type = type;
 
-    // check if window was created
-    if (!window->handle)
+    // create window with provided backend
+    if (!backend.Create(width, height, title))
     {
-        LogError(CHANNEL, "Window Creation Failed");
         return false;
     }
 
-    // set title
-    XStoreName(window->display, window->handle, title);
-
-    // set class
-    XClassHint class = { (char*)title, WINDOW_CLASS };
-    XSetClassHint(window->display, window->handle, &class);
-
-    // select window inputs
-    XSelectInput(window->display, window->handle, 
-            ExposureMask | KeyPressMask | KeyReleaseMask | ButtonPressMask | ButtonReleaseMask);
-
-    // init exit request
-    window->exitRequest = XInternAtom(window->display, "WM_DELETE_WINDOW", False);
-    XSetWMProtocols(window->display, window->handle, &window->exitRequest, 1);
-
-    // show the window
-    XMapWindow(window->display, window->handle);
-
-    // return success
-    LogSuccess(CHANNEL, "Window Created %dx%d \"%s\"", width, height, title);
+    // ConfigureNotify only reports changes, so subscribers learn starting size from this resize
+    WindowSize size = backend.GetSize();
+    ResizeEventPayload resize = { size.width, size.height };
+    SendWindowEvent(EVENT_TYPE_WINDOW_RESIZE, &resize, sizeof(resize));
     return true;
 }
 
 EXPORT void DestroyWindow(void)
 {
-    // destroy window
-    XDestroyWindow(window->display, window->handle);
-    LogSuccess(CHANNEL, "Window Destroyed");
-    
-    // destroy display
-    XCloseDisplay(window->display);
-    
-    // free allocated memory
-    FreeMemory(window, sizeof(LinuxWindow));
+    // input thread must not read window that is being destroyed
+    if (atomic_load(&isInputThreadRunning))
+    {
+        StopWindowInputThread();
+    }
+
+    backend.Destroy();
 }
 
 EXPORT void FireWindowEvents(void)
 {
-    // check if there is upcoming events
-    while (XPending(window->display))
+    // input thread owns event stream while it runs, new frame lets it send held motion, wake it if it has some
+    if (atomic_load_explicit(&isInputThreadRunning, memory_order_relaxed))
     {
-        // get next event
-        XNextEvent(window->display, &window->event);
-
-        // if window resized, store updated size here
-        XWindowAttributes attributes;
-
-        // look at events and fire them
-        switch (window->event.type) 
+        atomic_fetch_add_explicit(&frameCount, 1, memory_order_relaxed);
+        if (atomic_load_explicit(&isMotionHeld, memory_order_relaxed))
         {
-            case KeyPress:
-                FireEvent(EVENT_TYPE_KEY_PRESS);
-                SetEventArgI32(EVENT_TYPE_KEY_PRESS, 0, "Key", window->event.xkey.keycode);
-                break;
-            case KeyRelease:
-                FireEvent(EVENT_TYPE_KEY_RELEASE);
-                SetEventArgI32(EVENT_TYPE_KEY_RELEASE, 0, "Key", window->event.xkey.keycode);
-                break;
-            case Expose:
-                XGetWindowAttributes(window->display, window->handle, &attributes);
-                FireEvent(EVENT_TYPE_WINDOW_RESIZE);
-                SetEventArgI32(EVENT_TYPE_WINDOW_RESIZE, 0, "Width", attributes.width);
-                SetEventArgI32(EVENT_TYPE_WINDOW_RESIZE, 1, "Height", attributes.height);
-                break;
-            case ClientMessage:
-                if (window->event.xclient.data.l[0] == (u32)window->exitRequest)
-                {
-                    FireEvent(EVENT_TYPE_WINDOW_EXIT_REQUEST);
-                }
-                break;
+            backend.Wake();
         }
+        return;
     }
+
+    backend.FireEvents(false);
 }
 
 EXPORT WindowSize GetWindowSize(void)
 {
-    // store window attributes here (temp buffer)
-    XWindowAttributes attributes;
-
-    // get window attributes
-    XGetWindowAttributes(window->display, window->handle, &attributes);
-
-    // create structure
-    WindowSize size = { attributes.width, attributes.height };
+    return backend.GetSize();
+}
 
-    // return window size
-    return size;
+EXPORT WindowBackend GetWindowBackend(void)
+{
+    return backend.type;
 }
 
-Display* GetLinuxWindowDisplay(void)
+EXPORT b8 SetWindowCursorGrab(const b8 isGrabbed)
 {
-    return window->display;
+    return backend.SetCursorGrab(isGrabbed);
 }
 
-u32 GetLinuxWindowScreen(void)
+EXPORT b8 StartWindowInputThread(void)
 {
-    return window->screen;
+    // start thread with nothing held
+    heldMotion = (MouseMotionEventPayload){ 0 };
+    sentMotionFrame = atomic_load(&frameCount);
+    atomic_store(&isMotionHeld, false);
+    atomic_store(&isInputThreadRunning, true);
+    if (!CreateThread(&inputThread, RunInputThread, null))
+    {
+        atomic_store(&isInputThreadRunning, false);
+        LogWarning(CHANNEL, "Input Thread Not Created, Events Stay On Main Thread");
+        return false;
+    }
+
+    LogSuccess(CHANNEL, "Input Thread Started");
+    return true;
 }
 
-Window GetLinuxWindowRoot(void)
+EXPORT void StopWindowInputThread(void)
 {
-    return window->root;
+    // clear flag first, then wake thread so it sees it
+    atomic_store(&isInputThreadRunning, false);
+    backend.Wake();
+    JoinThread(&inputThread);
+
+    LogSuccess(CHANNEL, "Input Thread Stopped");
 }
 
-Window GetLinuxWindowHandle(void)
+void SendWindowEvent(const EventType type, const void* p_payload, const u16 size)
 {
-    return window->handle;
+    // event queue belongs to main thread, so input thread posts, if post queue is full event is dropped and counted
+    if (isInputThread)
+    {
+        PostEvent(type, p_payload, size);
+        return;
+    }
+
+    FireEvent(type, p_payload, size);
 }
 
-XEvent GetLinuxWindowEvent(void)
+static void* RunInputThread(void* p_data)
 {
-    return window->event;
+    (void)p_data;
+
+    isInputThread = true;
+
+    // sleep in backend until events arrive, each batch publishes new input snapshot
+    // lost server would wake thread right away forever, backend has already asked to exit, so stop
+    while (atomic_load(&isInputThreadRunning))
+    {
+        if (!backend.FireEvents(true))
+        {
+            LogWarning(CHANNEL, "Input Thread Stopped Reading, Window Server Lost");
+            break;
+        }
+    }
+
+    return null;
 }
 
 #endif
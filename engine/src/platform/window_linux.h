@@ -1,23 +1,23 @@
 #pragma once
 
 #include "defines.h"
-#include <X11/Xlib.h>
+#include "platform/window.h"
+#include "core/event.h"
 
-typedef struct LinuxWindow {
-    Display* display;
-    u32 screen;
-    Window root;
-    Window handle;
-    Atom exitRequest;
-    XEvent event;
-} LinuxWindow;
+typedef struct LinuxWindowBackend {
+    b8 (*Create)(const u16 width, const u16 height, const char* title);
+    void (*Destroy)(void);
+    b8 (*FireEvents)(const b8 wait);    // wait blocks until at least one event arrives, false once server is gone
+    void (*Wake)(void);                 // unblocks waiting FireEvents from other thread
+    WindowSize (*GetSize)(void);
+    b8 (*SetCursorGrab)(const b8 isGrabbed);
 
-Display* GetLinuxWindowDisplay(void);
+    WindowBackend type;
+} LinuxWindowBackend;
 
-u32 GetLinuxWindowScreen(void);
+// backends fire window events thro this, it posts them instead when called on input thread
+void SendWindowEvent(const EventType type, const void* p_payload, const u16 size);
 
-Window GetLinuxWindowRoot(void);
-
-Window GetLinuxWindowHandle(void);
-
-XEvent GetLinuxWindowEvent(void);
+// backends end every batch with this, it moves input mouse by raw motion, fires it and publishes input
+// on input thread raw motion is held and sent at most once per frame, raw devices report far more often than that
+void FlushWindowInput(const MouseMotionEventPayload* p_motion);
@@ -0,0 +1,366 @@
+#include "platform/window.h"
+
+#if defined(PLATFORM_LINUX)
+
+#define CHANNEL "XCB Window"
+
+#include "platform/window_xcb.h"
+#include "platform/window_linux.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+#include "core/memory.h"
+#include "core/event.h"
+#include "core/input.h"
+#include <xcb/xinput.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WM_PROTOCOLS "WM_PROTOCOLS"
+#define WM_DELETE_WINDOW "WM_DELETE_WINDOW"
+
+static XcbWindow* window = null;
+
+static void SelectXcbRawMotion(void);
+static void AddXcbRawMotion(xcb_input_raw_motion_event_t* p_raw, MouseMotionEventPayload* p_motion);
+
+b8 CreateXcbWindow(const u16 width, const u16 height, const char* title)
+{
+    PROFILE_FUNCTION();
+
+    // allocate structure on heap
+    window = AllocateMemory(sizeof(XcbWindow), MEMORY_TAG_WINDOW);
+
+    // check if singleton was allocated
+    if (!window)
+    {
+        LogError(CHANNEL, "Singleton Allocation Failed");
+        return false;
+    }
+
+    // connect to server
+    int screenIndex;
+    window->connection = xcb_connect(null, &screenIndex);
+
+    // check if connection was made
+    if (xcb_connection_has_error(window->connection))
+    {
+        LogError(CHANNEL, "Connection Failed");
+        xcb_disconnect(window->connection);
+        return false;
+    }
+
+    // get screen
+    xcb_screen_iterator_t screens = xcb_setup_roots_iterator(xcb_get_setup(window->connection));
+    for (int i = 0; i < screenIndex; i++)
+    {
+        xcb_screen_next(&screens);
+    }
+    window->screen = screens.data;
+
+    // ask for both atoms before waiting on any reply, so they cost one round trip
+    xcb_intern_atom_cookie_t protocolsCookie = 
+        xcb_intern_atom(window->connection, 1, strlen(WM_PROTOCOLS), WM_PROTOCOLS);
+    xcb_intern_atom_cookie_t exitRequestCookie = 
+        xcb_intern_atom(window->connection, 0, strlen(WM_DELETE_WINDOW), WM_DELETE_WINDOW);
+
+    // create window
+    u32 events = XCB_EVENT_MASK_STRUCTURE_NOTIFY | 
+        XCB_EVENT_MASK_KEY_PRESS | XCB_EVENT_MASK_KEY_RELEASE | 
+        XCB_EVENT_MASK_BUTTON_PRESS | XCB_EVENT_MASK_BUTTON_RELEASE | XCB_EVENT_MASK_POINTER_MOTION | 
+        XCB_EVENT_MASK_FOCUS_CHANGE;
+    window->handle = xcb_generate_id(window->connection);
+    xcb_create_window
+        (
+         window->connection, 
+         XCB_COPY_FROM_PARENT, 
+         window->handle, 
+         window->screen->root, 
+         0, 0, 
+         width, height, 
+         0, 
+         XCB_WINDOW_CLASS_INPUT_OUTPUT, 
+         window->screen->root_visual, 
+         XCB_CW_EVENT_MASK, &events
+         );
+
+    // set title
+    xcb_change_property(window->connection, XCB_PROP_MODE_REPLACE, window->handle, 
+            XCB_ATOM_WM_NAME, XCB_ATOM_STRING, 8, strlen(title), title);
+
+    // set class, instance and class names are stored back to back with their terminators
+    u32 titleLength = strlen(title) + 1;
+    char class[titleLength + sizeof(WINDOW_CLASS)];
+    memcpy(class, title, titleLength);
+    memcpy(class + titleLength, WINDOW_CLASS, sizeof(WINDOW_CLASS));
+    xcb_change_property(window->connection, XCB_PROP_MODE_REPLACE, window->handle, 
+            XCB_ATOM_WM_CLASS, XCB_ATOM_STRING, 8, sizeof(class), class);
+
+    // start from requested size, window manager may change it and tell with ConfigureNotify
+    atomic_store(&window->size, (u32)width << 16 | height);
+    window->isFocused = false;
+    window->isConnectionLost = false;
+
+    // init exit request
+    xcb_intern_atom_reply_t* protocols = xcb_intern_atom_reply(window->connection, protocolsCookie, null);
+    xcb_intern_atom_reply_t* exitRequest = xcb_intern_atom_reply(window->connection, exitRequestCookie, null);
+    if (!protocols || !exitRequest)
+    {
+        LogError(CHANNEL, "Exit Request Atoms Not Found");
+        free(protocols);
+        free(exitRequest);
+        xcb_disconnect(window->connection);
+        return false;
+    }
+    window->protocols = protocols->atom;
+    window->exitRequest = exitRequest->atom;
+    free(protocols);
+    free(exitRequest);
+    xcb_change_property(window->connection, XCB_PROP_MODE_REPLACE, window->handle, 
+            window->protocols, XCB_ATOM_ATOM, 32, 1, &window->exitRequest);
+
+    // raw mouse motion comes thro xinput2
+    SelectXcbRawMotion();
+
+    // show the window
+    xcb_map_window(window->connection, window->handle);
+    xcb_flush(window->connection);
+
+    // return success
+    LogSuccess(CHANNEL, "Window Created %dx%d \"%s\"", width, height, title);
+    return true;
+}
+
+void DestroyXcbWindow(void)
+{
+    // destroy window
+    xcb_destroy_window(window->connection, window->handle);
+    LogSuccess(CHANNEL, "Window Destroyed");
+
+    // close connection, flushes destroy request
+    xcb_disconnect(window->connection);
+
+    // free allocated memory
+    FreeMemory(window, sizeof(XcbWindow), MEMORY_TAG_WINDOW);
+}
+
+b8 FireXcbWindowEvents(const b8 wait)
+{
+    PROFILE_FUNCTION();
+
+    // payloads of fired events
+    KeyEventPayload key;
+    ResizeEventPayload resize;
+
+    // raw motion of this batch, fired as one event
+    MouseMotionEventPayload motion = { 0 };
+
+    // read socket once, blocking only when waiting, then drain what that read queued without touching socket again
+    xcb_generic_event_t* event = wait ? xcb_wait_for_event(window->connection) : xcb_poll_for_event(window->connection);
+    for (; event; event = xcb_poll_for_queued_event(window->connection))
+    {
+        // look at events, update input state and fire them, high bit only marks events sent by other clients
+        switch (event->response_type & ~0x80)
+        {
+            case XCB_KEY_PRESS:
+            {
+                xcb_key_press_event_t* press = (xcb_key_press_event_t*)event;
+                SetInputKey(press->detail, true, press->time);
+                key = (KeyEventPayload){ press->detail, press->time };
+                SendWindowEvent(EVENT_TYPE_KEY_PRESS, &key, sizeof(key));
+                break;
+            }
+            case XCB_KEY_RELEASE:
+            {
+                xcb_key_release_event_t* release = (xcb_key_release_event_t*)event;
+                SetInputKey(release->detail, false, release->time);
+                key = (KeyEventPayload){ release->detail, release->time };
+                SendWindowEvent(EVENT_TYPE_KEY_RELEASE, &key, sizeof(key));
+                break;
+            }
+            case XCB_BUTTON_PRESS:
+                SetInputButton(((xcb_button_press_event_t*)event)->detail, true, ((xcb_button_press_event_t*)event)->time);
+                break;
+            case XCB_BUTTON_RELEASE:
+                SetInputButton(((xcb_button_release_event_t*)event)->detail, false, ((xcb_button_release_event_t*)event)->time);
+                break;
+            case XCB_MOTION_NOTIFY:
+            {
+                xcb_motion_notify_event_t* pointer = (xcb_motion_notify_event_t*)event;
+                SetInputMousePosition(pointer->event_x, pointer->event_y, pointer->time);
+                break;
+            }
+            case XCB_GE_GENERIC:
+            {
+                // raw motion is selected on root, so it comes even when other window is focused
+                xcb_ge_generic_event_t* generic = (xcb_ge_generic_event_t*)event;
+                if (generic->extension == window->inputOpcode && generic->event_type == XCB_INPUT_RAW_MOTION && 
+                        window->isFocused)
+                {
+                    AddXcbRawMotion((xcb_input_raw_motion_event_t*)event, &motion);
+                }
+                break;
+            }
+            case XCB_FOCUS_IN:
+                window->isFocused = true;
+                break;
+            case XCB_FOCUS_OUT:
+                window->isFocused = false;
+                break;
+            case XCB_CONFIGURE_NOTIFY:
+            {
+                // moves also come here, only size changes are resizes
+                xcb_configure_notify_event_t* configure = (xcb_configure_notify_event_t*)event;
+                u32 size = (u32)configure->width << 16 | configure->height;
+                if (size != atomic_load_explicit(&window->size, memory_order_relaxed))
+                {
+                    atomic_store_explicit(&window->size, size, memory_order_relaxed);
+                    resize = (ResizeEventPayload){ configure->width, configure->height };
+                    SendWindowEvent(EVENT_TYPE_WINDOW_RESIZE, &resize, sizeof(resize));
+                }
+                break;
+            }
+            case XCB_CLIENT_MESSAGE:
+                if (((xcb_client_message_event_t*)event)->data.data32[0] == window->exitRequest)
+                {
+                    SendWindowEvent(EVENT_TYPE_WINDOW_EXIT_REQUEST, null, 0);
+                }
+                break;
+        }
+
+        // events are allocated by xcb
+        free(event);
+    }
+
+    // fire motion of whole batch at once and hand input read in this batch to main thread
+    FlushWindowInput(&motion);
+
+    // broken connection returns no events without blocking, so ask to exit once and let caller stop reading
+    if (xcb_connection_has_error(window->connection))
+    {
+        if (!window->isConnectionLost)
+        {
+            window->isConnectionLost = true;
+            LogError(CHANNEL, "Connection Lost {Error: %d}", xcb_connection_has_error(window->connection));
+            SendWindowEvent(EVENT_TYPE_WINDOW_EXIT_REQUEST, null, 0);
+        }
+        return false;
+    }
+
+    return true;
+}
+
+void WakeXcbWindow(void)
+{
+    // empty client message, it only makes blocked xcb_wait_for_event return
+    xcb_client_message_event_t wake = 
+    { 
+        .response_type = XCB_CLIENT_MESSAGE, 
+        .format = 32, 
+        .window = window->handle 
+    };
+    xcb_send_event(window->connection, 0, window->handle, XCB_EVENT_MASK_NO_EVENT, (const char*)&wake);
+    xcb_flush(window->connection);
+}
+
+WindowSize GetXcbWindowSize(void)
+{
+    // size as of last processed ConfigureNotify, packed so other threads never see half of it
+    u32 size = atomic_load_explicit(&window->size, memory_order_relaxed);
+    return (WindowSize){ size >> 16, size & 0xFFFF };
+}
+
+b8 SetXcbWindowCursorGrab(const b8 isGrabbed)
+{
+    // release pointer
+    if (!isGrabbed)
+    {
+        xcb_ungrab_pointer(window->connection, XCB_CURRENT_TIME);
+        xcb_flush(window->connection);
+        return true;
+    }
+
+    // grab pointer and confine it to window, pointer events keep coming to window
+    xcb_grab_pointer_cookie_t cookie = xcb_grab_pointer(window->connection, 1, window->handle, 
+            XCB_EVENT_MASK_BUTTON_PRESS | XCB_EVENT_MASK_BUTTON_RELEASE | XCB_EVENT_MASK_POINTER_MOTION, 
+            XCB_GRAB_MODE_ASYNC, XCB_GRAB_MODE_ASYNC, window->handle, XCB_NONE, XCB_CURRENT_TIME);
+    xcb_grab_pointer_reply_t* reply = xcb_grab_pointer_reply(window->connection, cookie, null);
+    u8 result = reply ? reply->status : XCB_GRAB_STATUS_INVALID_TIME;
+    free(reply);
+    if (result != XCB_GRAB_STATUS_SUCCESS)
+    {
+        LogWarning(CHANNEL, "Cursor Grab Failed {Result: %d}", result);
+        return false;
+    }
+
+    return true;
+}
+
+xcb_connection_t* GetXcbWindowConnection(void)
+{
+    return window->connection;
+}
+
+xcb_window_t GetXcbWindowHandle(void)
+{
+    return window->handle;
+}
+
+static void SelectXcbRawMotion(void)
+{
+    // window works without xinput2, only motion events are missing
+    window->inputOpcode = 0;
+    const xcb_query_extension_reply_t* extension = xcb_get_extension_data(window->connection, &xcb_input_id);
+    if (!extension || !extension->present)
+    {
+        LogWarning(CHANNEL, "XInput2 Not Found, Raw Mouse Motion Disabled");
+        return;
+    }
+
+    // raw events need xinput 2.0
+    xcb_input_xi_query_version_reply_t* version = xcb_input_xi_query_version_reply(window->connection, 
+            xcb_input_xi_query_version(window->connection, 2, 0), null);
+    if (!version || version->major_version < 2)
+    {
+        LogWarning(CHANNEL, "XInput2 Too Old, Raw Mouse Motion Disabled");
+        free(version);
+        return;
+    }
+    free(version);
+
+    // raw events can only be selected on root window, mask words follow mask header
+    struct {
+        xcb_input_event_mask_t header;
+        u32 mask;
+    } eventMask = { { XCB_INPUT_DEVICE_ALL_MASTER, 1 }, XCB_INPUT_XI_EVENT_MASK_RAW_MOTION };
+    xcb_input_xi_select_events(window->connection, window->screen->root, 1, &eventMask.header);
+    window->inputOpcode = extension->major_opcode;
+}
+
+static void AddXcbRawMotion(xcb_input_raw_motion_event_t* p_raw, MouseMotionEventPayload* p_motion)
+{
+    // raw values hold only axes set in mask, in axis order, axis 0 is x and axis 1 is y
+    const u32* mask = xcb_input_raw_button_press_valuator_mask(p_raw);
+    const xcb_input_fp3232_t* p_value = xcb_input_raw_button_press_axisvalues_raw(p_raw);
+    for (u32 axis = 0; axis < 2 && axis < p_raw->valuators_len * 32u; axis++)
+    {
+        if (mask[axis / 32] & (1u << (axis % 32)))
+        {
+            // fixed point 32.32
+            f32 value = p_value->integral + p_value->frac / 4294967296.0;
+            if (axis == 0)
+            {
+                p_motion->deltaX += value;
+            }
+            else
+            {
+                p_motion->deltaY += value;
+            }
+            p_value++;
+        }
+    }
+
+    p_motion->timestamp = p_raw->time;
+    p_motion->sampleCount++;
+}
+
+#endif
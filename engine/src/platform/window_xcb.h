@@ -0,0 +1,35 @@
+#pragma once
+
+#include "defines.h"
+#include "platform/window.h"
+#include <xcb/xcb.h>
+#include <stdatomic.h>
+
+typedef struct XcbWindow {
+    xcb_connection_t* connection;
+    xcb_screen_t* screen;
+    xcb_window_t handle;
+    xcb_atom_t protocols;
+    xcb_atom_t exitRequest;
+    _Atomic u32 size;                   // width << 16 | height, kept up to date from ConfigureNotify, read from any thread
+    u8 inputOpcode;                     // xinput2 extension opcode, 0 if server has no xinput2
+    b8 isFocused;
+    b8 isConnectionLost;                // exit request was sent for broken connection
+} XcbWindow;
+
+b8 CreateXcbWindow(const u16 width, const u16 height, const char* title);
+
+void DestroyXcbWindow(void);
+
+// returns false once connection is broken, first such call fires exit request
+b8 FireXcbWindowEvents(const b8 wait);
+
+void WakeXcbWindow(void);
+
+WindowSize GetXcbWindowSize(void);
+
+b8 SetXcbWindowCursorGrab(const b8 isGrabbed);
+
+xcb_connection_t* GetXcbWindowConnection(void);
+
+xcb_window_t GetXcbWindowHandle(void);
@@ -0,0 +1,309 @@
+#include "platform/window.h"
+
+#if defined(PLATFORM_LINUX)
+
+#define CHANNEL "Xlib Window"
+
+#include "platform/window_xlib.h"
+#include "platform/window_linux.h"
+#include "core/assert.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+#include "core/memory.h"
+#include "core/event.h"
+#include "core/input.h"
+#include <X11/Xutil.h>
+#include <X11/extensions/XInput2.h>
+
+static XlibWindow* window = null;
+
+static void SelectXlibRawMotion(void);
+static void AddXlibRawMotion(const XIRawEvent* p_raw, MouseMotionEventPayload* p_motion);
+
+b8 CreateXlibWindow(const u16 width, const u16 height, const char* title)
+{
+    PROFILE_FUNCTION();
+
+    // allocate structure on heap
+    window = AllocateMemory(sizeof(XlibWindow), MEMORY_TAG_WINDOW);
+
+    // check if singleton was allocated
+    if (!window)
+    {
+        LogError(CHANNEL, "Singleton Allocation Failed");
+        return false;
+    }
+
+    // input thread reads events while main thread may still use display, xlib needs this before any other call
+    XInitThreads();
+
+    // create display
+    window->display = XOpenDisplay(null);
+
+    // check if display was created
+    if (!window->display)
+    {
+        LogError(CHANNEL, "Display Creation Failed");
+        return false;
+    }
+
+    // get screen
+    window->screen = DefaultScreen(window->display);
+
+    // get root window
+    window->root = RootWindow(window->display, window->screen);
+
+    // create window
+    window->handle = XCreateSimpleWindow
+        (
+         window->display, 
+         window->root, 
+         0, 0, 
+         width, height, 
+         0, 0, 0
+         );
+
+    // check if window was created
+    if (!window->handle)
+    {
+        LogError(CHANNEL, "Window Creation Failed");
+        return false;
+    }
+
+    // set title
+    XStoreName(window->display, window->handle, title);
+
+    // set class
+    XClassHint class = { (char*)title, WINDOW_CLASS };
+    XSetClassHint(window->display, window->handle, &class);
+
+    // start from requested size, window manager may change it and tell with ConfigureNotify
+    atomic_store(&window->size, (u32)width << 16 | height);
+    window->isFocused = false;
+
+    // select window inputs
+    XSelectInput(window->display, window->handle, 
+            StructureNotifyMask | KeyPressMask | KeyReleaseMask | 
+            ButtonPressMask | ButtonReleaseMask | PointerMotionMask | FocusChangeMask);
+
+    // raw mouse motion comes thro xinput2
+    SelectXlibRawMotion();
+
+    // init exit request
+    window->exitRequest = XInternAtom(window->display, "WM_DELETE_WINDOW", False);
+    XSetWMProtocols(window->display, window->handle, &window->exitRequest, 1);
+
+    // show the window
+    XMapWindow(window->display, window->handle);
+
+    // return success
+    LogSuccess(CHANNEL, "Window Created %dx%d \"%s\"", width, height, title);
+    return true;
+}
+
+void DestroyXlibWindow(void)
+{
+    // destroy window
+    XDestroyWindow(window->display, window->handle);
+    LogSuccess(CHANNEL, "Window Destroyed");
+    
+    // destroy display
+    XCloseDisplay(window->display);
+    
+    // free allocated memory
+    FreeMemory(window, sizeof(XlibWindow), MEMORY_TAG_WINDOW);
+}
+
+b8 FireXlibWindowEvents(const b8 wait)
+{
+    PROFILE_FUNCTION();
+
+    // raw motion of this batch, fired as one event
+    MouseMotionEventPayload motion = { 0 };
+
+    // check if there is upcoming events, when waiting first event is read even if none is pending
+    XEvent event;
+    for (b8 block = wait; block || XPending(window->display); block = false)
+    {
+        // get next event
+        XNextEvent(window->display, &event);
+
+        // payloads of fired events
+        KeyEventPayload key;
+        ResizeEventPayload resize;
+        u32 size;
+
+        // look at events, update input state and fire them
+        switch (event.type) 
+        {
+            case KeyPress:
+                SetInputKey(event.xkey.keycode, true, event.xkey.time);
+                key = (KeyEventPayload){ event.xkey.keycode, event.xkey.time };
+                SendWindowEvent(EVENT_TYPE_KEY_PRESS, &key, sizeof(key));
+                break;
+            case KeyRelease:
+                SetInputKey(event.xkey.keycode, false, event.xkey.time);
+                key = (KeyEventPayload){ event.xkey.keycode, event.xkey.time };
+                SendWindowEvent(EVENT_TYPE_KEY_RELEASE, &key, sizeof(key));
+                break;
+            case ButtonPress:
+                SetInputButton(event.xbutton.button, true, event.xbutton.time);
+                break;
+            case ButtonRelease:
+                SetInputButton(event.xbutton.button, false, event.xbutton.time);
+                break;
+            case MotionNotify:
+                SetInputMousePosition(event.xmotion.x, event.xmotion.y, event.xmotion.time);
+                break;
+            case GenericEvent:
+                // raw motion is selected on root, so it comes even when other window is focused
+                if (event.xcookie.extension == window->inputOpcode && window->isFocused &&
+                        XGetEventData(window->display, &event.xcookie))
+                {
+                    if (event.xcookie.evtype == XI_RawMotion)
+                    {
+                        AddXlibRawMotion(event.xcookie.data, &motion);
+                    }
+                    XFreeEventData(window->display, &event.xcookie);
+                }
+                break;
+            case FocusIn:
+                window->isFocused = true;
+                break;
+            case FocusOut:
+                window->isFocused = false;
+                break;
+            case ConfigureNotify:
+                // moves also come here, only size changes are resizes
+                size = (u32)event.xconfigure.width << 16 | event.xconfigure.height;
+                if (size != atomic_load_explicit(&window->size, memory_order_relaxed))
+                {
+                    atomic_store_explicit(&window->size, size, memory_order_relaxed);
+                    resize = (ResizeEventPayload){ event.xconfigure.width, event.xconfigure.height };
+                    SendWindowEvent(EVENT_TYPE_WINDOW_RESIZE, &resize, sizeof(resize));
+                }
+                break;
+            case ClientMessage:
+                if (event.xclient.data.l[0] == (u32)window->exitRequest)
+                {
+                    SendWindowEvent(EVENT_TYPE_WINDOW_EXIT_REQUEST, null, 0);
+                }
+                break;
+        }
+    }
+
+    // fire motion of whole batch at once and hand input read in this batch to main thread
+    FlushWindowInput(&motion);
+    return true;
+}
+
+void WakeXlibWindow(void)
+{
+    // empty client message, it only makes blocked XNextEvent return
+    XEvent wake = { .xclient = { .type = ClientMessage, .window = window->handle, .format = 32 } };
+    XSendEvent(window->display, window->handle, False, NoEventMask, &wake);
+    XFlush(window->display);
+}
+
+WindowSize GetXlibWindowSize(void)
+{
+    // size as of last processed ConfigureNotify, packed so other threads never see half of it
+    u32 size = atomic_load_explicit(&window->size, memory_order_relaxed);
+    return (WindowSize){ size >> 16, size & 0xFFFF };
+}
+
+b8 SetXlibWindowCursorGrab(const b8 isGrabbed)
+{
+    // release pointer
+    if (!isGrabbed)
+    {
+        XUngrabPointer(window->display, CurrentTime);
+        XFlush(window->display);
+        return true;
+    }
+
+    // grab pointer and confine it to window, pointer events keep coming to window
+    i32 result = XGrabPointer(window->display, window->handle, True, 
+            ButtonPressMask | ButtonReleaseMask | PointerMotionMask, 
+            GrabModeAsync, GrabModeAsync, window->handle, None, CurrentTime);
+    if (result != GrabSuccess)
+    {
+        LogWarning(CHANNEL, "Cursor Grab Failed {Result: %d}", result);
+        return false;
+    }
+
+    return true;
+}
+
+Display* GetXlibWindowDisplay(void)
+{
+    return window->display;
+}
+
+u32 GetXlibWindowScreen(void)
+{
+    return window->screen;
+}
+
+Window GetXlibWindowRoot(void)
+{
+    return window->root;
+}
+
+Window GetXlibWindowHandle(void)
+{
+    return window->handle;
+}
+
+static void SelectXlibRawMotion(void)
+{
+    // window works without xinput2, only motion events are missing
+    window->inputOpcode = 0;
+    i32 event, error;
+    if (!XQueryExtension(window->display, "XInputExtension", &window->inputOpcode, &event, &error))
+    {
+        LogWarning(CHANNEL, "XInput2 Not Found, Raw Mouse Motion Disabled");
+        return;
+    }
+
+    // raw events need xinput 2.0
+    i32 major = 2, minor = 0;
+    if (XIQueryVersion(window->display, &major, &minor) != Success)
+    {
+        LogWarning(CHANNEL, "XInput2 Too Old, Raw Mouse Motion Disabled {Version: %d.%d}", major, minor);
+        window->inputOpcode = 0;
+        return;
+    }
+
+    // raw events can only be selected on root window
+    u8 mask[XIMaskLen(XI_RawMotion)] = { 0 };
+    XISetMask(mask, XI_RawMotion);
+    XIEventMask eventMask = { XIAllMasterDevices, sizeof(mask), mask };
+    XISelectEvents(window->display, window->root, &eventMask, 1);
+}
+
+static void AddXlibRawMotion(const XIRawEvent* p_raw, MouseMotionEventPayload* p_motion)
+{
+    // raw values hold only axes set in mask, in axis order, axis 0 is x and axis 1 is y
+    const f64* p_value = p_raw->raw_values;
+    for (i32 axis = 0; axis < 2 && axis < p_raw->valuators.mask_len * 8; axis++)
+    {
+        if (XIMaskIsSet(p_raw->valuators.mask, axis))
+        {
+            if (axis == 0)
+            {
+                p_motion->deltaX += *p_value;
+            }
+            else
+            {
+                p_motion->deltaY += *p_value;
+            }
+            p_value++;
+        }
+    }
+
+    p_motion->timestamp = p_raw->time;
+    p_motion->sampleCount++;
+}
+
+#endif
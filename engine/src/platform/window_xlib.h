@@ -0,0 +1,38 @@
+#pragma once
+
+#include "defines.h"
+#include "platform/window.h"
+#include <X11/Xlib.h>
+#include <stdatomic.h>
+
+typedef struct XlibWindow {
+    Display* display;
+    u32 screen;
+    Window root;
+    Window handle;
+    Atom exitRequest;
+    _Atomic u32 size;                   // width << 16 | height, kept up to date from ConfigureNotify, read from any thread
+    i32 inputOpcode;                    // xinput2 extension opcode, 0 if server has no xinput2
+    b8 isFocused;
+} XlibWindow;
+
+b8 CreateXlibWindow(const u16 width, const u16 height, const char* title);
+
+void DestroyXlibWindow(void);
+
+// xlib exits process thro its io error handler when server is lost, so this always returns true
+b8 FireXlibWindowEvents(const b8 wait);
+
+void WakeXlibWindow(void);
+
+WindowSize GetXlibWindowSize(void);
+
+b8 SetXlibWindowCursorGrab(const b8 isGrabbed);
+
+Display* GetXlibWindowDisplay(void);
+
+u32 GetXlibWindowScreen(void);
+
+Window GetXlibWindowRoot(void);
+
+Window GetXlibWindowHandle(void);
@@ -0,0 +1,22 @@
+#include "renderer/null_renderer.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+
+#define CHANNEL "Null Renderer"
+
+b8 StartupNullRenderer(void)
+{
+    PROFILE_FUNCTION();
+
+    LogSuccess(CHANNEL, SYSTEM_INITIALIZED_MESSAGE);
+    return true;
+}
+
+void ShutdownNullRenderer(void)
+{
+    LogSuccess(CHANNEL, SYSTEM_TERMINATED_MESSAGE);
+}
+
+void DrawNullFrame(void)
+{
+}
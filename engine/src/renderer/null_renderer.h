@@ -0,0 +1,10 @@
+#pragma once
+
+#include "renderer/renderer_defines.h"
+
+// backend that draws nothing, lets engine loop run without window or gpu
+b8 StartupNullRenderer(void);
+
+void ShutdownNullRenderer(void);
+
+void DrawNullFrame(void);
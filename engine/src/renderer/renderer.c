@@ -1,10 +1,15 @@
 #include "renderer/renderer.h"
 #include "defines.h"
 #include "renderer/vulkan_renderer.h"
+#include "renderer/null_renderer.h"
 #include "core/event.h"
 #include "core/stack_allocator.h"
+#include "core/frame_allocator.h"
+#include "core/memory.h"
 #include "core/assert.h"
 #include "core/logger.h"
+#include "core/profiler.h"
+#include "core/frame_stats.h"
 
 #define CHANNEL "Renderer"
 
@@ -16,11 +21,13 @@ static Renderer* renderer;
 
 b8 StartupRenderer(const RendererBackend backend)
 {
+    PROFILE_FUNCTION();
+
     // make sure system is not started
     Assert(CHANNEL, initialized == false, "System Is Already Initialized");
 
     // create stack allocator
-    if (!CreateStackAllocator(&allocator, 2 * sizeof(Renderer)))
+    if (!CreateStackAllocator(&allocator, 2 * sizeof(Renderer), MEMORY_TAG_RENDERER))
     {
         LogError(CHANNEL, "Allocator Creation Failed");
         return false;
@@ -38,6 +45,12 @@ b8 StartupRenderer(const RendererBackend backend)
             renderer->DrawFrame = DrawVKFrame;
             LogInfo(CHANNEL, "Backend Choosen: \"%s\"", "Vulkan");
             break;
+        case RENDERER_BACKEND_NULL:
+            renderer->Startup = StartupNullRenderer;
+            renderer->Shutdown = ShutdownNullRenderer;
+            renderer->DrawFrame = DrawNullFrame;
+            LogInfo(CHANNEL, "Backend Choosen: \"%s\"", "Null");
+            break;
         default:
             LogError(CHANNEL, "Invalid Backend Provided");
             return false;
@@ -81,9 +94,19 @@ void ShutdownRenderer(void)
 
 void DrawFrame(void)
 {
+    PROFILE_FUNCTION();
+
     // make sure system is started
     Assert(CHANNEL, initialized, "System Not Initialized Yet");
 
     // draw frame with backend
+    BeginFramePhase(FRAME_PHASE_RENDER);
     renderer->DrawFrame();
+    EndFramePhase(FRAME_PHASE_RENDER);
+
+    // end of frame, so release memory of frame before the previous one
+    SwapFrameAllocator();
+
+    // allocations made from here on count against next frame
+    EndMemoryFrame();
 }
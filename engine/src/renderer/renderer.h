@@ -3,7 +3,8 @@
 #include "renderer/renderer_defines.h"
 
 typedef enum RendererBackend {
-    RENDERER_BACKEND_VULKAN
+    RENDERER_BACKEND_VULKAN,
+    RENDERER_BACKEND_NULL               // draws nothing, for headless runs
 } RendererBackend;
 
 typedef struct Renderer {
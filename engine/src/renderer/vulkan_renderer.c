@@ -3,9 +3,13 @@
 #include "platform/window.h"
 #include "core/stack_allocator.h"
 #include "core/logger.h"
+#include "core/profiler.h"
 
 #define CHANNEL "Vulkan Renderer"
 
+// space for temp arrays used while enumerating vulkan objects
+#define SCRATCH_SIZE (4 * 1024)
+
 static StackAllocator allocator;
 
 static VKRenderer* renderer;
@@ -29,8 +33,11 @@ static void DestroyVKSwapchain(void);
 
 b8 StartupVKRenderer(void) 
 {
+    PROFILE_FUNCTION();
+
     // create allocator
-    if (!CreateStackAllocator(&allocator, 2 * sizeof(VKRenderer))) 
+    if (!CreateStackAllocator(&allocator,
+                sizeof(VKRenderer) + STACK_ALLOCATOR_GUARD_SIZE + SCRATCH_SIZE, MEMORY_TAG_RENDERER)) 
     {
         LogError(CHANNEL, "Stack Allocator Creation Failed");
         return false;
@@ -263,10 +270,6 @@ static b8 ChooseVKPhysicalDevice(void)
     vkEnumeratePhysicalDevices(renderer->Instance, &gpuCount, null);
     LogInfo(CHANNEL, "GPU Found: %d", gpuCount);
 
-    // get gpus
-    VkPhysicalDevice* gpus = RequestStackAllocatorMemory(&allocator, gpuCount * sizeof(VkPhysicalDevice));
-    vkEnumeratePhysicalDevices(renderer->Instance, &gpuCount, gpus);
-
     // check if at list 1 gpu is found
     if (gpuCount == 0)
     {
@@ -274,6 +277,14 @@ static b8 ChooseVKPhysicalDevice(void)
         return false;
     }
 
+    // remember top of stack, so temp arrays are freed in one call
+    StackAllocatorMarker marker = GetStackAllocatorMarker(&allocator);
+
+    // get gpus
+    VkPhysicalDevice* gpus = RequestStackAllocatorMemoryAligned(&allocator,
+            gpuCount * sizeof(VkPhysicalDevice), _Alignof(VkPhysicalDevice));
+    vkEnumeratePhysicalDevices(renderer->Instance, &gpuCount, gpus);
+
     // log gpus in debug mode
 #if defined(DEBUG)
     for (u32 i = 0; i < gpuCount; i++)
@@ -356,7 +367,7 @@ static b8 ChooseVKPhysicalDevice(void)
     }
 
     // free gpus from heap
-    FreeStackAllocatorMemory(&allocator, gpuCount * sizeof(VkPhysicalDevice));
+    FreeStackAllocatorToMarker(&allocator, marker);
 
     // if gpu is not found, return failure
     if (!gpuFound)
@@ -379,7 +390,9 @@ static b8 CreateVKDevice(void)
 
     // create queue create info
     u8 queueInfoCount = renderer->GraphicsQueueFamilyIndex == renderer->PresentQueueFamilyIndex ? 1 : 2;
-    VkDeviceQueueCreateInfo* queueInfos = RequestStackAllocatorMemory(&allocator, queueInfoCount * sizeof(VkDeviceQueueCreateInfo));
+    StackAllocatorMarker marker = GetStackAllocatorMarker(&allocator);
+    VkDeviceQueueCreateInfo* queueInfos = RequestStackAllocatorMemoryAligned(&allocator,
+            queueInfoCount * sizeof(VkDeviceQueueCreateInfo), _Alignof(VkDeviceQueueCreateInfo));
     float queuePriority = 1.0f;
     for (u8 i = 0; i < queueInfoCount; i++)
     {
@@ -433,7 +446,7 @@ static b8 CreateVKDevice(void)
     VkResult result = vkCreateDevice(renderer->GPU, &deviceInfo, null, &renderer->Device);
 
     // free queue infos from heap
-    FreeStackAllocatorMemory(&allocator, queueInfoCount * sizeof(VkDeviceQueueCreateInfo));
+    FreeStackAllocatorToMarker(&allocator, marker);
 
     // check if device was created
     if (result != VK_SUCCESS)
@@ -547,7 +560,9 @@ static b8 CreateVKSwapchain(void)
     LogInfo(CHANNEL, "Surface Format Found: %d", surfaceFormatCount);
 
     // get surface formats
-    VkSurfaceFormatKHR* surfaceFormats = RequestStackAllocatorMemory(&allocator, surfaceFormatCount * sizeof(VkSurfaceFormatKHR));
+    StackAllocatorMarker marker = GetStackAllocatorMarker(&allocator);
+    VkSurfaceFormatKHR* surfaceFormats = RequestStackAllocatorMemoryAligned(&allocator,
+            surfaceFormatCount * sizeof(VkSurfaceFormatKHR), _Alignof(VkSurfaceFormatKHR));
     vkGetPhysicalDeviceSurfaceFormatsKHR(renderer->GPU, renderer->Surface, &surfaceFormatCount, surfaceFormats);
 
     // choose best surface format
@@ -563,7 +578,7 @@ static b8 CreateVKSwapchain(void)
     }
 
     // free surface formats
-    FreeStackAllocatorMemory(&allocator, surfaceFormatCount * sizeof(VkSurfaceFormatKHR));
+    FreeStackAllocatorToMarker(&allocator, marker);
 
     // calculate correct image count
     u32 imageCount = surfaceCapabilities.minImageCount + 1;
@@ -0,0 +1,128 @@
+#include "test.h"
+#include "core/event.h"
+#include "core/frame_allocator.h"
+#include "platform/thread.h"
+
+#define CHANNEL TEST_LOG_CHANNEL
+
+#define FRAME_MEMORY_SIZE (1024 * 1024)
+#define PRODUCER_COUNT 4
+#define EVENTS_PER_PRODUCER 1000000
+#define PRODUCER_RETRY_MICROSECONDS 50
+#define EVENT_LOG_CHANNEL "Event System"
+
+// producers tag events, so subscriber can check per producer order
+typedef struct OrderEventPayload {
+    u32 producer;
+    u32 sequence;
+} OrderEventPayload;
+
+typedef struct OrderProducer {
+    Thread thread;
+    u32 index;
+} OrderProducer;
+
+static EventType orderEventType = INVALID_EVENT_TYPE;
+static u32 expectedSequences[PRODUCER_COUNT];
+static u64 receivedCount = 0;
+static u64 unorderedCount = 0;
+
+static void OnOrderEvent(const Event* p_event)
+{
+    // events of one producer must come in order they were posted, with none missing
+    const OrderEventPayload* p_payload = GetEventPayload(p_event, OrderEventPayload);
+    if (p_payload->producer >= PRODUCER_COUNT || p_payload->sequence != expectedSequences[p_payload->producer])
+    {
+        unorderedCount++;
+    }
+    expectedSequences[p_payload->producer % PRODUCER_COUNT] = p_payload->sequence + 1;
+    receivedCount++;
+}
+
+static void* RunOrderProducer(void* p_data)
+{
+    OrderProducer* p_producer = p_data;
+
+    // retry until main thread drains post queue, sleeping gives it cpu when cores are few
+    for (u32 i = 0; i < EVENTS_PER_PRODUCER; i++)
+    {
+        OrderEventPayload payload = { p_producer->index, i };
+        while (!PostEvent(orderEventType, &payload, sizeof(payload)))
+        {
+            SleepThread(PRODUCER_RETRY_MICROSECONDS);
+        }
+    }
+    return null;
+}
+
+static b8 RunPostEventOrder(void)
+{
+    // event system needs frame memory for batch subs
+    if (!StartupFrameAllocator(FRAME_MEMORY_SIZE) || !StartupEventSystem())
+    {
+        return false;
+    }
+
+    // producers fill post queue on purpose, its drop warnings would only bury result
+    SetLogChannelFlags(EVENT_LOG_CHANNEL, LOG_VERBOSITY_FLAG_ERROR);
+
+    // type is registered on main thread before producers start
+    orderEventType = RegisterEventType("Order_Event", sizeof(OrderEventPayload));
+    SubToEvent(orderEventType, OnOrderEvent);
+    for (u32 i = 0; i < PRODUCER_COUNT; i++)
+    {
+        expectedSequences[i] = 0;
+    }
+    receivedCount = 0;
+    unorderedCount = 0;
+
+    // start producers
+    OrderProducer producers[PRODUCER_COUNT];
+    u32 producerCount = 0;
+    for (u32 i = 0; i < PRODUCER_COUNT; i++)
+    {
+        producers[i].index = i;
+        if (!CreateThread(&producers[i].thread, RunOrderProducer, &producers[i]))
+        {
+            LogError(CHANNEL, "Producer Not Created {Index: %d}", i);
+            break;
+        }
+        producerCount++;
+    }
+
+    // deliver everything thro same path frames use
+    u64 expected = (u64)producerCount * EVENTS_PER_PRODUCER;
+    while (receivedCount < expected)
+    {
+        ProcessEvents();
+        SwapFrameAllocator();
+    }
+
+    // wait for producers
+    for (u32 i = 0; i < producerCount; i++)
+    {
+        JoinThread(&producers[i].thread);
+    }
+
+    // nothing may arrive after last expected event
+    ProcessEvents();
+    b8 isPassed = producerCount == PRODUCER_COUNT && receivedCount == expected && unorderedCount == 0;
+    if (!isPassed)
+    {
+        LogError(CHANNEL, "Posted Events Out Of Order {Received: %lu, Expected: %lu, Unordered: %lu}",
+                receivedCount, expected, unorderedCount);
+    }
+
+    UnsubToEvent(orderEventType, OnOrderEvent);
+    ShutdownEventSystem();
+    ClearLogChannelFlags(EVENT_LOG_CHANNEL);
+    ShutdownFrameAllocator();
+    return isPassed;
+}
+
+static const Test tests[] =
+{
+    { "event/post_order", RunPostEventOrder }
+};
+
+const TestList eventTests = { tests, sizeof(tests) / sizeof(tests[0]) };
@@ -0,0 +1,59 @@
+#include "test.h"
+#include "core/memory.h"
+#include "platform/clock.h"
+#include <string.h>
+
+#define CHANNEL TEST_LOG_CHANNEL
+
+static const TestList* lists[] =
+{ &eventTests };
+
+// usage: test [name filter], exits with 1 if any test failed
+int main(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : null;
+
+    // startup systems every test needs
+    StartupLogSystem(LOG_VERBOSITY_FLAG_ERROR | LOG_VERBOSITY_FLAG_WARNING | LOG_VERBOSITY_FLAG_SUCCESS);
+    StartupMemorySystem(0);
+
+    // run every test that matches filter
+    u32 passedCount = 0;
+    u32 failedCount = 0;
+    for (u32 i = 0; i < sizeof(lists) / sizeof(lists[0]); i++)
+    {
+        for (u32 j = 0; j < lists[i]->count; j++)
+        {
+            const Test* p_test = &lists[i]->tests[j];
+            if (filter && !strstr(p_test->name, filter))
+            {
+                continue;
+            }
+
+            u64 start = GetClockNanoseconds();
+            if (p_test->Run())
+            {
+                LogSuccess(CHANNEL, "Passed {Name: %s, Time: %.3fs}", p_test->name, (GetClockNanoseconds() - start) / 1e9);
+                passedCount++;
+            }
+            else
+            {
+                LogError(CHANNEL, "Failed {Name: %s}", p_test->name);
+                failedCount++;
+            }
+        }
+    }
+
+    // shutdown systems
+    if (failedCount > 0)
+    {
+        LogError(CHANNEL, "Tests Failed {Passed: %d, Failed: %d}", passedCount, failedCount);
+    }
+    else
+    {
+        LogSuccess(CHANNEL, "Tests Passed {Passed: %d}", passedCount);
+    }
+    ShutdownMemorySystem();
+    ShutdownLogSystem();
+    return failedCount > 0 ? 1 : 0;
+}
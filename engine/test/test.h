@@ -0,0 +1,19 @@
+#pragma once
+
+#include "defines.h"
+#include "core/logger.h"
+
+#define TEST_LOG_CHANNEL "Test"
+
+typedef struct Test {
+    const char* name;
+    b8 (*Run)(void);                    // returns false if test found wrong results
+} Test;
+
+typedef struct TestList {
+    const Test* tests;
+    u32 count;
+} TestList;
+
+// test lists, one per file
+extern const TestList eventTests;
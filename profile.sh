@@ -0,0 +1,7 @@
+cd engine
+bear -- make -f linux.mk profile
+cd ..
+cd testbed
+bear -- make -f linux.mk profile
+LD_LIBRARY_PATH=../bin ./../bin/testbed --trace ../bin/trace.json
+cd ..
@@ -0,0 +1,12 @@
+cd engine
+make -f linux.mk debug
+make -f linux.mk test
+./../bin/test
+status=$?
+cd ..
+cd testbed
+make -f linux.mk debug
+make -f linux.mk run_headless
+status=$((status | $?))
+cd ..
+exit $status
@@ -4,6 +4,7 @@ LIBRARIES = -lengine
 FLAGS = -Wall -Wextra -Isrc -I../engine/src -L../bin
 RELEASE_FLAGS = -O3
 DEBUG_FLAGS = -g -DDEBUG -O0
+PROFILE_FLAGS = -O3 -DPROFILING
 
 release:
 	$(COMPILER) $(SOURCES) $(LIBRARIES) $(FLAGS) $(RELEASE_FLAGS) -o ../bin/testbed
@@ -11,8 +12,14 @@ release:
 debug:
 	$(COMPILER) $(SOURCES) $(LIBRARIES) $(FLAGS) $(DEBUG_FLAGS) -o ../bin/testbed
 
+profile:
+	$(COMPILER) $(SOURCES) $(LIBRARIES) $(FLAGS) $(PROFILE_FLAGS) -o ../bin/testbed
+
 run:
 	LD_LIBRARY_PATH=../bin ./../bin/testbed
 
+run_headless:
+	LD_LIBRARY_PATH=../bin ./../bin/testbed --headless --frames 600
+
 run_debug:
 	LD_LIBRARY_PATH=../bin gdb ../bin/testbed
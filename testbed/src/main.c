@@ -1,42 +1,265 @@
+#include <stdlib.h>
+#include <string.h>
 #include <core/logger.h>
+#include <core/log_file_sink.h>
+#include <core/profiler.h>
 #include <core/memory.h>
+#include <core/frame_allocator.h>
+#include <core/frame_stats.h>
 #include <core/event.h>
+#include <core/event_recorder.h>
+#include <core/input.h>
 #include <platform/window.h>
 #include <renderer/renderer.h>
 
+#define HEADLESS_DEFAULT_FRAME_COUNT 600
+
 static b8 isRunning = true;
 
+// set by --record <path> or --replay <path>, replay runs without window and gpu
+static b8 isRecording = false;
+static b8 isReplaying = false;
+static const char* recordingPath = null;
+
+// set by --log <path>
+static const char* logPath = null;
+static LogFileSink logFile;
+static LogSink logFileSink;
+
+// set by --trace <path>, zones are only recorded in profile builds
+static const char* tracePath = null;
+
+// set by --headless, runs without window and gpu on generated input, any allocation past warm up fails run
+static b8 isHeadless = false;
+
+// set by --xcb, window talks to x server thro xcb instead of xlib
+static WindowBackend windowBackend = WINDOW_BACKEND_XLIB;
+
+// set by --input-thread, window events are read on own thread and polled as snapshots
+static b8 isInputThreaded = false;
+
+// set by --frames <count>, 0 runs until window is closed
+static u64 frameLimit = 0;
+
+// mouse look, turned by raw mouse motion while cursor is grabbed
+static f32 cameraYaw = 0;
+static f32 cameraPitch = 0;
+static b8 isCursorGrabbed = false;
+
 void onCloseRequest(const Event* p_event)
 {
     isRunning = false;
 }
 
-int main(void)
+// stands in for window input, so headless frames go thro same event paths
+static void FireHeadlessEvents(const u64 frame)
+{
+    KeyEventPayload key = { .keycode = 38 + frame % 26, .timestamp = frame * 16 };
+    FireEvent(EVENT_TYPE_KEY_PRESS, &key, sizeof(key));
+    FireEvent(EVENT_TYPE_KEY_RELEASE, &key, sizeof(key));
+    ResizeEventPayload resize = { .width = 1000 + frame % 2, .height = 800 };
+    FireEvent(EVENT_TYPE_WINDOW_RESIZE, &resize, sizeof(resize));
+
+    // same input goes to input state, like window backends do
+    SetInputKey(key.keycode, true, key.timestamp);
+    SetInputKey(key.keycode, false, key.timestamp);
+    SetInputMousePosition(frame % 1000, frame % 800, key.timestamp);
+    PublishInput();
+}
+
+// per frame game step, polls input snapshot like game would
+static void UpdateTestbed(const b8 hasWindow)
 {
-    // startup systems
-    StartupLogSystem(LOG_VERBOSITY_FLAG_ERROR | LOG_VERBOSITY_FLAG_WARNING | LOG_VERBOSITY_FLAG_SUCCESS | LOG_VERBOSITY_FLAG_INFO);
-    StartupMemorySystem();
+    // click grabs cursor for mouse look, escape lets it go
+    if (hasWindow && WasButtonPressed(1) && !isCursorGrabbed)
+    {
+        isCursorGrabbed = SetWindowCursorGrab(true);
+    }
+    else if (hasWindow && WasKeyPressed(9) && isCursorGrabbed)
+    {
+        isCursorGrabbed = !SetWindowCursorGrab(false);
+    }
+
+    // turn camera by motion of this frame, pitch stops at straight up and down
+    i32 deltaX, deltaY;
+    GetMouseDelta(&deltaX, &deltaY);
+    if (isCursorGrabbed || !hasWindow)
+    {
+        cameraYaw += deltaX * 0.1f;
+        cameraPitch -= deltaY * 0.1f;
+        cameraPitch = cameraPitch > 89 ? 89 : cameraPitch < -89 ? -89 : cameraPitch;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // read command line options
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--headless") == 0)
+        {
+            isHeadless = true;
+        }
+        else if (strcmp(argv[i], "--xcb") == 0)
+        {
+            windowBackend = WINDOW_BACKEND_XCB;
+        }
+        else if (strcmp(argv[i], "--input-thread") == 0)
+        {
+            isInputThreaded = true;
+        }
+        else if (i + 1 == argc)
+        {
+            break;
+        }
+        else if (strcmp(argv[i], "--record") == 0)
+        {
+            isRecording = true;
+            recordingPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--replay") == 0)
+        {
+            isReplaying = true;
+            recordingPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--log") == 0)
+        {
+            logPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--trace") == 0)
+        {
+            tracePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--frames") == 0)
+        {
+            frameLimit = strtoull(argv[++i], null, 10);
+        }
+    }
+    if (isHeadless && frameLimit == 0)
+    {
+        frameLimit = HEADLESS_DEFAULT_FRAME_COUNT;
+    }
+
+    // startup systems, profiler right after logger so it can report and sees every other startup
+    StartupLogSystem(LOG_VERBOSITY_FLAG_ALL | LOG_FLAG_ASYNC);
+    if (tracePath && !StartupProfiler(256 * 1024))
+    {
+        tracePath = null;
+    }
+    if (logPath && CreateLogFileSink(&logFile, logPath, 4 * 1024 * 1024, 3, LOG_FILE_FORMAT_JSON))
+    {
+        logFileSink = GetLogFileSink(&logFile, LOG_VERBOSITY_FLAG_ALL);
+        AddLogSink(&logFileSink);
+    }
+    u8 memoryFlags = isHeadless ? MEMORY_FLAG_STRICT_FRAME_ALLOCATIONS : MEMORY_FLAG_COUNT_FRAME_ALLOCATIONS;
+#if defined(DEBUG)
+    StartupMemorySystem(memoryFlags | MEMORY_FLAG_PROFILE_ALLOCATIONS);
+#else
+    StartupMemorySystem(memoryFlags);
+#endif
+    StartupFrameAllocator(1024 * 1024);
+    StartupFrameStats(5000000000, 5000000000);
     StartupEventSystem();
+    StartupInputSystem();
     SubToEvent(EVENT_TYPE_WINDOW_EXIT_REQUEST, onCloseRequest);
-    CreateWindow(1000, 800, "Cubic Game");
-    StartupRenderer(RENDERER_BACKEND_VULKAN);
+    if (isRecording || isReplaying)
+    {
+        if (!StartupEventRecorder(isRecording ? EVENT_RECORDER_MODE_RECORD : EVENT_RECORDER_MODE_REPLAY, recordingPath))
+        {
+            isRecording = isReplaying = false;
+        }
+    }
+    b8 isWindowless = isHeadless || isReplaying;
+    if (isWindowless)
+    {
+        StartupRenderer(RENDERER_BACKEND_NULL);
+    }
+    else
+    {
+        CreateWindow(windowBackend, 1000, 800, "Cubic Game");
+        StartupRenderer(RENDERER_BACKEND_VULKAN);
+
+        // window events move to own thread once window and renderer are up
+        if (isInputThreaded)
+        {
+            StartWindowInputThread();
+        }
+    }
 
     // game loop
-    while (isRunning)
+    for (u64 frame = 0; isRunning && (frameLimit == 0 || frame < frameLimit); frame++)
     {
-        // poll & process events
-        FireWindowEvents();
+        PROFILE_SCOPE("Frame");
+        BeginFrameStats();
+
+        // poll & process events, replay feeds recorded input instead of window
+        BeginFramePhase(FRAME_PHASE_EVENTS);
+        if (isReplaying)
+        {
+            isRunning = UpdateEventRecorder();
+        }
+        else
+        {
+            if (isHeadless)
+            {
+                FireHeadlessEvents(frame);
+            }
+            else
+            {
+                FireWindowEvents();
+            }
+            if (isRecording)
+            {
+                UpdateEventRecorder();
+            }
+        }
+
+        // take input snapshot before callbacks run, so they and rest of frame read same fresh state
+        // with input thread nothing above touches input, so this is first thing frame does with it
+        UpdateInput();
         ProcessEvents();
+        EndFramePhase(FRAME_PHASE_EVENTS);
+
+        // update game
+        BeginFramePhase(FRAME_PHASE_UPDATE);
+        UpdateTestbed(!isWindowless);
+        EndFramePhase(FRAME_PHASE_UPDATE);
 
         // draw on screen
         DrawFrame();
+        EndFrameStats();
     }
 
     // shutdown systems
     ShutdownRenderer();
-    DestroyWindow();
+    if (!isWindowless)
+    {
+        DestroyWindow();
+    }
+    if (isRecording || isReplaying)
+    {
+        ShutdownEventRecorder();
+    }
     UnsubToEvent(EVENT_TYPE_WINDOW_EXIT_REQUEST, onCloseRequest);
+    ShutdownInputSystem();
     ShutdownEventSystem();
+    ShutdownFrameStats();
+    ShutdownFrameAllocator();
+    MemoryFrameStats memoryFrames;
+    GetMemoryFrameStats(&memoryFrames);
     ShutdownMemorySystem();
+    if (tracePath)
+    {
+        WriteProfilerTrace(tracePath);
+        ShutdownProfiler();
+    }
+    if (logFileSink.Write)
+    {
+        RemoveLogSink(&logFileSink);
+        DestroyLogFileSink(&logFile);
+    }
     ShutdownLogSystem();
+
+    // headless run is test, steady frames must not allocate
+    return isHeadless && memoryFrames.steadyAllocationCount > 0 ? 1 : 0;
 }